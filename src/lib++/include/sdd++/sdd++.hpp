@@ -29,6 +29,8 @@
 #include <optional>
 #include <vector>
 #include <functional>
+#include <string>
+#include <utility>
 #include <cstdint>
 #include <cstdlib>
 
@@ -49,6 +51,11 @@ namespace sdd {
     enabled
   };
 
+  enum class quantifier {
+    exists = 0,
+    forall
+  };
+
   class node;
   class variable;
   class literal;
@@ -56,6 +63,15 @@ namespace sdd {
   class manager {
   public:
     manager(size_t var_count, GC gc = GC::disabled);
+    // the vtree is read from the vtree cache in cache_directory when it has a
+    // similar cnf, otherwise it is built from the structure of the cnf by
+    // method ("min-fill", "min-degree" or "dtree")
+    manager(
+      size_t var_count, std::vector<std::vector<sdd::literal>> const& clauses,
+      std::string const& method = "min-fill",
+      std::optional<std::string> const& cache_directory = std::nullopt,
+      GC gc = GC::disabled
+    );
     manager(manager const&) = delete;
     manager(manager &&) = default;
     
@@ -70,11 +86,39 @@ namespace sdd {
     void add_var_after_last();
     void add_var_before(variable var);
     void add_var_after(variable var);
+    void add_vars_before(size_t count, variable var);
+    void add_vars_after(size_t count, variable var);
+    void add_vars_before_root(size_t count);
+    void add_vars_after_root(size_t count);
+    std::vector<std::optional<variable>> remove_unused_vars();
+
+    void deferred_refs_on();
+    void deferred_refs_off();
+    bool is_deferred_refs_on() const;
+    void flush_deferred_refs();
+
+    bool gc_step(size_t budget);
+    void set_gc_step_budget(size_t budget);
+
+    // saves the current vtree as the cache entry of the cnf in directory,
+    // returns false if directory cannot be written
+    bool save_vtree_to_cache(
+      std::string const& directory,
+      std::vector<std::vector<sdd::literal>> const& clauses
+    ) const;
 
     node literal(sdd::literal lit);
     node top();
     node bottom();
 
+    node at_most(size_t k, std::vector<variable> const& vars);
+    node at_least(size_t k, std::vector<variable> const& vars);
+    node exactly(size_t k, std::vector<variable> const& vars);
+    node parity(std::vector<variable> const& vars);
+    node linear_leq(
+      std::vector<std::pair<variable, int64_t>> const& terms, int64_t bound
+    );
+
     sdd_manager_t *sdd() const { return _mgr.get(); }
 
   private:
@@ -157,6 +201,15 @@ namespace sdd {
     friend node forall(variable var, node n);
     friend node exists(std::vector<variable> const& vars, node n);
     friend node forall(std::vector<variable> const& vars, node n);
+    friend node and_exists(
+      std::vector<variable> const& vars, node n1, node n2
+    );
+    friend node quantify(
+      std::vector<std::pair<quantifier, std::vector<variable>>> const& prefix,
+      node n
+    );
+    friend node iff(node n1, node n2);
+    friend node ite(node n1, node n2, node n3);
 
     node condition(class literal lit) const;
     node condition(std::vector<class literal> const& lits) const;
@@ -166,6 +219,12 @@ namespace sdd {
     node rename(std::function<sdd::variable(sdd::variable)> renaming);
     node rename(std::unordered_map<sdd::variable, sdd::variable> const&);
 
+    node compose(variable var, node g) const;
+    node compose(std::unordered_map<sdd::variable, node> const& map) const;
+
+    node restrict_to(node care) const;
+    node constrain(node care) const;
+
     bool is_valid() const;
     bool is_sat() const;
     bool is_unsat() const;
@@ -192,12 +251,18 @@ namespace sdd {
   node forall(variable var, node n);
   node exists(std::vector<variable> const& vars, node n);
   node forall(std::vector<variable> const& vars, node n);
+  node and_exists(std::vector<variable> const& vars, node n1, node n2);
+  node quantify(
+    std::vector<std::pair<quantifier, std::vector<variable>>> const& prefix,
+    node n
+  );
   node implies(node n1, node n2);
   node implies(node n, literal l);
   node implies(literal l, node n);
   node iff(node n1, node n2);
   node iff(node n, literal l);
   node iff(literal l, node n);
+  node ite(node n1, node n2, node n3);
 
   struct element {
     node prime;
@@ -26,9 +26,11 @@
 
 #include <sdd/sdd.h>
 
+#include <cstdlib>
 #include <memory>
 #include <algorithm>
 #include <vector>
+#include <string>
 #include <cassert>
 
 #include <iostream>
@@ -44,6 +46,82 @@ namespace sdd {
       &sdd_manager_free
     } { }
 
+  // clauses in the form of the C api
+  struct cnf_arrays {
+    std::vector<SddLiteral> lengths;
+    std::vector<std::vector<SddLiteral>> literals;
+    std::vector<SddLiteral*> clauses;
+  };
+
+  static cnf_arrays sdd_cnf(
+    size_t var_count, std::vector<std::vector<literal>> const& clauses
+  ) {
+    cnf_arrays cnf;
+    for(auto const& clause : clauses) {
+      std::vector<SddLiteral> lits;
+      for(auto lit : clause) {
+        if(long(lit) == 0 || unsigned(lit.variable()) > var_count)
+          throw std::invalid_argument("invalid literal in clause");
+        lits.push_back(SddLiteral(lit));
+      }
+      cnf.lengths.push_back(SddLiteral(lits.size()));
+      cnf.literals.push_back(std::move(lits));
+    }
+    for(auto& lits : cnf.literals)
+      cnf.clauses.push_back(lits.data());
+    return cnf;
+  }
+
+  static sdd_manager_t *manager_from_cnf(
+    size_t var_count, std::vector<std::vector<literal>> const& clauses,
+    std::string const& method, std::optional<std::string> const& cache_directory,
+    GC gc
+  ) {
+    if(var_count == 0)
+      throw std::invalid_argument("manager needs at least one variable");
+    if(method != "min-fill" && method != "min-degree" && method != "dtree")
+      throw std::invalid_argument("unknown vtree method: " + method);
+
+    cnf_arrays cnf = sdd_cnf(var_count, clauses);
+    Vtree *vtree = nullptr;
+    if(cache_directory)
+      vtree = sdd_vtree_cache_read_cnf(
+        cache_directory->c_str(), SddLiteral(var_count),
+        SddSize(cnf.clauses.size()), cnf.lengths.data(), cnf.clauses.data()
+      );
+    if(vtree == nullptr)
+      vtree = sdd_vtree_new_from_cnf(
+        SddLiteral(var_count), SddSize(cnf.clauses.size()),
+        cnf.lengths.data(), cnf.clauses.data(), method.c_str()
+      );
+
+    sdd_manager_t *mgr = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    if(gc == GC::enabled)
+      sdd_manager_auto_gc_and_minimize_on(mgr);
+    return mgr;
+  }
+
+  manager::manager(
+    size_t var_count, std::vector<std::vector<sdd::literal>> const& clauses,
+    std::string const& method, std::optional<std::string> const& cache_directory,
+    GC gc
+  ) : _mgr{
+      manager_from_cnf(var_count, clauses, method, cache_directory, gc),
+      &sdd_manager_free
+    } { }
+
+  bool manager::save_vtree_to_cache(
+    std::string const& directory,
+    std::vector<std::vector<sdd::literal>> const& clauses
+  ) const {
+    cnf_arrays cnf = sdd_cnf(var_count(), clauses);
+    return sdd_vtree_cache_save_cnf(
+      directory.c_str(), SddLiteral(var_count()), SddSize(cnf.clauses.size()),
+      cnf.lengths.data(), cnf.clauses.data(), sdd_manager_vtree(sdd())
+    );
+  }
+
   size_t manager::var_count() const {
     return size_t(sdd_manager_var_count(sdd()));
   }
@@ -87,6 +165,60 @@ namespace sdd {
     sdd_manager_add_var_after(SddLiteral(unsigned(var)), sdd());
   }
 
+  void manager::add_vars_before(size_t count, variable var) {
+    sdd_manager_add_vars(SddLiteral(count), 'l', SddLiteral(unsigned(var)), sdd());
+  }
+
+  void manager::add_vars_after(size_t count, variable var) {
+    sdd_manager_add_vars(SddLiteral(count), 'r', SddLiteral(unsigned(var)), sdd());
+  }
+
+  void manager::add_vars_before_root(size_t count) {
+    sdd_manager_add_vars(SddLiteral(count), 'l', 0, sdd());
+  }
+
+  void manager::add_vars_after_root(size_t count) {
+    sdd_manager_add_vars(SddLiteral(count), 'r', 0, sdd());
+  }
+
+  // element i of the result is the new variable of the old variable i, if kept
+  std::vector<std::optional<variable>> manager::remove_unused_vars() {
+    size_t count = var_count();
+    auto map = std::make_unique<SddLiteral[]>(count + 1);
+
+    sdd_manager_remove_unused_vars(map.get(), sdd());
+
+    std::vector<std::optional<variable>> vars(count + 1);
+    for(size_t i = 1; i <= count; i++)
+      if(map[i] != 0)
+        vars[i] = variable(unsigned(map[i]));
+    return vars;
+  }
+
+  void manager::deferred_refs_on() {
+    sdd_manager_deferred_refs_on(sdd());
+  }
+
+  void manager::deferred_refs_off() {
+    sdd_manager_deferred_refs_off(sdd());
+  }
+
+  bool manager::is_deferred_refs_on() const {
+    return sdd_manager_is_deferred_refs_on(sdd());
+  }
+
+  void manager::flush_deferred_refs() {
+    sdd_manager_flush_deferred_refs(sdd());
+  }
+
+  bool manager::gc_step(size_t budget) {
+    return sdd_manager_gc_step(SddSize(budget), sdd());
+  }
+
+  void manager::set_gc_step_budget(size_t budget) {
+    sdd_manager_set_gc_step_budget(SddSize(budget), sdd());
+  }
+
   node manager::literal(sdd::literal lit) {
     sdd::variable var = lit.variable();
     if(unsigned(var) > var_count())
@@ -102,17 +234,80 @@ namespace sdd {
     return node{this, sdd_manager_false(sdd())};
   }
 
+  static std::vector<SddLiteral> 
+  sdd_vars(std::vector<variable> const& vars, size_t var_count) {
+    std::vector<SddLiteral> result;
+    for(auto var : vars) {
+      if(unsigned(var) < 1 || unsigned(var) > var_count)
+        throw std::invalid_argument("variable out of range");
+      result.push_back(SddLiteral(unsigned(var)));
+    }
+    return result;
+  }
+
+  node manager::at_most(size_t k, std::vector<variable> const& vars) {
+    auto v = sdd_vars(vars, var_count());
+    return node{
+      this, sdd_at_most_k(SddLiteral(k), SddLiteral(v.size()), v.data(), sdd())
+    };
+  }
+
+  node manager::at_least(size_t k, std::vector<variable> const& vars) {
+    auto v = sdd_vars(vars, var_count());
+    return node{
+      this, sdd_at_least_k(SddLiteral(k), SddLiteral(v.size()), v.data(), sdd())
+    };
+  }
+
+  node manager::exactly(size_t k, std::vector<variable> const& vars) {
+    auto v = sdd_vars(vars, var_count());
+    return node{
+      this, sdd_exactly_k(SddLiteral(k), SddLiteral(v.size()), v.data(), sdd())
+    };
+  }
+
+  node manager::parity(std::vector<variable> const& vars) {
+    auto v = sdd_vars(vars, var_count());
+    return node{this, sdd_parity(SddLiteral(v.size()), v.data(), sdd())};
+  }
+
+  node manager::linear_leq(
+    std::vector<std::pair<variable, int64_t>> const& terms, int64_t bound
+  ) {
+    size_t n = var_count();
+    std::vector<SddLiteral> weights(n + 1, 0);
+    for(auto const& [var, w] : terms) {
+      if(unsigned(var) < 1 || unsigned(var) > n)
+        throw std::invalid_argument("variable out of range");
+      weights[unsigned(var)] += SddLiteral(w);
+    }
+    return node{this, sdd_linear_leq(weights.data(), SddLiteral(bound), sdd())};
+  }
+
   //
   // node
   //
+  // literals are not reference counted: a node wrapping a literal holds its
+  // variable instead, so that remove_unused_vars() keeps it
+  //
+  // compaction cannot redirect the pointer held here, so every node pins its
+  // manager (sdd_manager_compact() fails while nodes exist)
   node::node(class manager *mgr, SddNode *n) 
     : _mgr{mgr}, _node{
       std::shared_ptr<SddNode>{
         sdd_ref(n, mgr->sdd()), [=](SddNode *_n) {
           sdd_deref(_n, mgr->sdd());
+          if(sdd_node_is_literal(_n))
+            sdd_manager_release_var(std::abs(sdd_node_literal(_n)), mgr->sdd());
+          sdd_manager_unpin(mgr->sdd());
         }
       }
-    } { }
+    } 
+  { 
+    sdd_manager_pin(mgr->sdd());
+    if(sdd_node_is_literal(n))
+      sdd_manager_hold_var(std::abs(sdd_node_literal(n)), mgr->sdd());
+  }
 
   std::vector<variable> node::variables() const {
     auto vars = make_array_ptr(sdd_variables(sdd(), manager()->sdd()));
@@ -174,8 +369,50 @@ namespace sdd {
     };
   }
 
+  node and_exists(std::vector<variable> const& vars, node n1, node n2) {
+    std::vector<int> map(n1.manager()->var_count() + 1, 0);
+
+    for(auto var : vars)
+      map[unsigned(var)] = 1;
+    
+    return node{
+      n1.manager(), 
+      sdd_and_exists(n1.sdd(), n2.sdd(), map.data(), n1.manager()->sdd())
+    };
+  }
+
   node forall(std::vector<variable> const& vars, node n) {
-    return !exists(vars, !n);
+    std::vector<int> map(n.manager()->var_count() + 1, 0);
+
+    for(auto var : vars)
+      map[unsigned(var)] = 1;
+    
+    return node{
+      n.manager(), 
+      sdd_forall_multiple(map.data(), n.sdd(), n.manager()->sdd())
+    };
+  }
+
+  node quantify(
+    std::vector<std::pair<quantifier, std::vector<variable>>> const& prefix,
+    node n
+  ) {
+    std::string quantifiers;
+    std::vector<SddSize> blocks(n.manager()->var_count() + 1, 0);
+
+    for(auto const& [q, vars] : prefix) {
+      quantifiers.push_back(q == quantifier::exists ? 'e' : 'a');
+      for(auto var : vars)
+        blocks[unsigned(var)] = quantifiers.size();
+    }
+
+    return node{
+      n.manager(),
+      sdd_quantify_prefix(
+        quantifiers.size(), quantifiers.data(), blocks.data(), 
+        n.sdd(), n.manager()->sdd()
+      )
+    };
   }
    
   node forall(variable var, node n) {
@@ -186,7 +423,7 @@ namespace sdd {
   }
 
   node implies(node n1, node n2) { 
-    return !n1 || n2;
+    return ite(n1, n2, n1.manager()->top());
   }
 
   node implies(node n, literal l) {
@@ -198,7 +435,9 @@ namespace sdd {
   }
 
   node iff(node n1, node n2) {
-    return implies(n1, n2) && implies(n2, n1);
+    return node{
+      n1.manager(), sdd_equiv(n1.sdd(), n2.sdd(), n1.manager()->sdd())
+    };
   }
 
   node iff(node n, literal l) {
@@ -209,6 +448,13 @@ namespace sdd {
     return iff(n.manager()->literal(l), n);
   }
 
+  node ite(node n1, node n2, node n3) {
+    return node{
+      n1.manager(), 
+      sdd_ite(n1.sdd(), n2.sdd(), n3.sdd(), n1.manager()->sdd())
+    };
+  }
+
   node node::condition(class literal lit) const {
     return node{
       manager(), sdd_condition(SddLiteral(lit), sdd(), manager()->sdd())
@@ -259,6 +505,41 @@ namespace sdd {
     });
   }
 
+  node node::compose(variable var, node g) const {
+    return node{
+      manager(),
+      sdd_compose(sdd(), SddLiteral(unsigned(var)), g.sdd(), manager()->sdd())
+    };
+  }
+
+  node node::compose(std::unordered_map<sdd::variable, node> const& map) const {
+    size_t n = manager()->var_count();
+    std::vector<SddNode *> compose_map(n + 1, nullptr);
+
+    for(auto const& [var, g] : map) {
+      if(unsigned(var) < 1 || unsigned(var) > n)
+        throw std::invalid_argument("variable out of range");
+      compose_map[unsigned(var)] = g.sdd();
+    }
+
+    return node{
+      manager(),
+      sdd_vector_compose(sdd(), compose_map.data(), manager()->sdd())
+    };
+  }
+
+  node node::restrict_to(node care) const {
+    return node{
+      manager(), sdd_restrict(sdd(), care.sdd(), manager()->sdd())
+    };
+  }
+
+  node node::constrain(node care) const {
+    return node{
+      manager(), sdd_constrain(sdd(), care.sdd(), manager()->sdd())
+    };
+  }
+
   bool node::is_valid() const {
     return sdd_node_is_true(sdd());
   }
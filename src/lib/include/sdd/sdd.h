@@ -54,6 +54,16 @@ typedef struct vtree_t Vtree;
 typedef struct sdd_node_t SddNode;
 typedef struct sdd_manager_t SddManager;
 typedef struct wmc_manager_t WmcManager;
+typedef struct reach_manager_t ReachManager;
+
+//statistics of one fixpoint iteration of reachability
+typedef struct reach_stats_t {
+  SddSize frontier_size; //size of the frontier whose image was computed
+  SddSize image_size; //size of the image
+  SddSize reached_size; //size of the reached states after the iteration
+  SddSize live_count; //live nodes in manager after the iteration (and gc)
+  float time; //seconds
+} ReachStats;
 
 typedef struct vtree_t* SddVtreeSearchFunc(struct vtree_t*, struct sdd_manager_t*);
 
@@ -72,6 +82,8 @@ void sdd_manager_auto_gc_and_minimize_off(SddManager* manager);
 int sdd_manager_is_auto_gc_and_minimize_on(SddManager* manager);
 void sdd_manager_set_minimize_function(SddVtreeSearchFunc func, SddManager* manager);
 void sdd_manager_unset_minimize_function(SddManager* manager);
+void sdd_manager_set_auto_search_policy(char policy, SddManager* manager);
+float sdd_manager_auto_search_growth(char threshold, SddManager* manager);
 void* sdd_manager_options(SddManager* manager);
 void sdd_manager_set_options(void* options, SddManager* manager);
 int sdd_manager_is_var_used(SddLiteral var, SddManager* manager);
@@ -83,22 +95,37 @@ void sdd_manager_add_var_before_first(SddManager* manager);
 void sdd_manager_add_var_after_last(SddManager* manager);
 void sdd_manager_add_var_before(SddLiteral target_var, SddManager* manager);
 void sdd_manager_add_var_after(SddLiteral target_var, SddManager* manager);
+void sdd_manager_add_vars(SddLiteral count, char location, SddLiteral target_var, SddManager* manager);
+void sdd_manager_hold_var(SddLiteral var, SddManager* manager);
+void sdd_manager_release_var(SddLiteral var, SddManager* manager);
+SddLiteral sdd_manager_remove_unused_vars(SddLiteral* renumber_map, SddManager* manager);
 
 // TERMINAL SDDS
 SddNode* sdd_manager_true(const SddManager* manager);
 SddNode* sdd_manager_false(const SddManager* manager);
-SddNode* sdd_manager_literal(const SddLiteral literal, SddManager* manager);
+SddNode* sdd_manager_literal(const SddLiteral literal, const SddManager* manager);
+SddNode* sdd_at_most_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager);
+SddNode* sdd_at_least_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager);
+SddNode* sdd_exactly_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager);
+SddNode* sdd_linear_leq(SddLiteral* weights, SddLiteral bound, SddManager* manager);
+SddNode* sdd_parity(SddLiteral count, SddLiteral* vars, SddManager* manager);
 
 // SDD QUERIES AND TRANSFORMATIONS
 SddNode* sdd_apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager);
 SddNode* sdd_conjoin(SddNode* node1, SddNode* node2, SddManager* manager);
 SddNode* sdd_disjoin(SddNode* node1, SddNode* node2, SddManager* manager);
+SddNode* sdd_ite(SddNode* node1, SddNode* node2, SddNode* node3, SddManager* manager);
+SddNode* sdd_xor(SddNode* node1, SddNode* node2, SddManager* manager);
+SddNode* sdd_equiv(SddNode* node1, SddNode* node2, SddManager* manager);
 SddNode* sdd_negate(SddNode* node, SddManager* manager);
 SddNode* sdd_condition(SddLiteral lit, SddNode* node, SddManager* manager);
 SddNode* sdd_exists(SddLiteral var, SddNode* node, SddManager* manager);
 SddNode* sdd_exists_multiple(int* exists_map, SddNode* node, SddManager* manager);
 SddNode* sdd_exists_multiple_static(int* exists_map, SddNode* node, SddManager* manager);
+SddNode* sdd_and_exists(SddNode* node1, SddNode* node2, int* exists_map, SddManager* manager);
 SddNode* sdd_forall(SddLiteral var, SddNode* node, SddManager* manager);
+SddNode* sdd_forall_multiple(int* forall_map, SddNode* node, SddManager* manager);
+SddNode* sdd_quantify_prefix(SddSize block_count, const char* quantifiers, SddSize* var_blocks, SddNode* node, SddManager* manager);
 SddNode* sdd_minimize_cardinality(SddNode* node, SddManager* manager);
 SddNode* sdd_global_minimize_cardinality(SddNode* node, SddManager* manager);
 SddLiteral sdd_minimum_cardinality(SddNode* node);
@@ -121,7 +148,13 @@ SddSize sdd_id(SddNode* node);
 int sdd_garbage_collected(SddNode* node, SddSize id);
 Vtree* sdd_vtree_of(SddNode* node);
 SddNode* sdd_copy(SddNode* node, SddManager* dest_manager);
+SddNode* sdd_transfer(SddNode* node, SddManager* dest_manager);
+void sdd_transfer_multiple(SddSize count, SddNode** nodes, SddNode** transfers, SddManager* dest_manager);
 SddNode* sdd_rename_variables(SddNode* node, SddLiteral* variable_map, SddManager* manager);
+SddNode* sdd_compose(SddNode* node, SddLiteral var, SddNode* g, SddManager* manager);
+SddNode* sdd_vector_compose(SddNode* node, SddNode** compose_map, SddManager* manager);
+SddNode* sdd_restrict(SddNode* node, SddNode* care, SddManager* manager);
+SddNode* sdd_constrain(SddNode* node, SddNode* care, SddManager* manager);
 int* sdd_variables(SddNode* node, SddManager* manager);
 
 // SDD FILE I/O
@@ -166,11 +199,14 @@ SddSize sdd_vtree_dead_count_above(const Vtree* vtree);
 Vtree* sdd_vtree_new(SddLiteral var_count, const char* type);
 Vtree* sdd_vtree_new_with_var_order(SddLiteral var_count, SddLiteral* var_order, const char* type);
 Vtree* sdd_vtree_new_X_constrained(SddLiteral var_count, SddLiteral* is_X_var, const char* type);
+Vtree* sdd_vtree_new_from_cnf(SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses, const char* method);
 void sdd_vtree_free(Vtree* vtree);
 
 // VTREE FILE I/O
 void sdd_vtree_save(const char* fname, Vtree* vtree);
 Vtree* sdd_vtree_read(const char* filename);
+Vtree* sdd_vtree_cache_read_cnf(const char* directory, SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses);
+int sdd_vtree_cache_save_cnf(const char* directory, SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses, Vtree* vtree);
 void sdd_vtree_save_as_dot(const char* fname, Vtree* vtree);
 
 // SDD MANAGER VTREE
@@ -212,16 +248,44 @@ void sdd_vtree_set_search_state(void* search_state, Vtree* vtree);
 SddRefCount sdd_ref_count(SddNode* node);
 SddNode* sdd_ref(SddNode* node, SddManager* manager);
 SddNode* sdd_deref(SddNode* node, SddManager* manager);
+//in deferred mode, sdd_ref and sdd_deref update the count of their argument only: until
+//sdd_manager_flush_deferred_refs, the reference counts of its descendants and the live
+//and dead counts and sizes of the manager and its vtrees (sdd_manager_live_count,
+//sdd_manager_dead_count, sdd_manager_live_size, ...) are stale (gc, vtree operations
+//and minimization flush them first)
+void sdd_manager_deferred_refs_on(SddManager* manager);
+void sdd_manager_deferred_refs_off(SddManager* manager);
+int sdd_manager_is_deferred_refs_on(SddManager* manager);
+void sdd_manager_flush_deferred_refs(SddManager* manager);
 void sdd_manager_garbage_collect(SddManager* manager);
 void sdd_vtree_garbage_collect(Vtree* vtree, SddManager* manager);
 int sdd_manager_garbage_collect_if(float dead_node_threshold, SddManager* manager);
 int sdd_vtree_garbage_collect_if(float dead_node_threshold, Vtree* vtree, SddManager* manager);
+int sdd_manager_gc_step(SddSize budget, SddManager* manager);
+void sdd_manager_set_gc_step_budget(SddSize budget, SddManager* manager);
+//relocates live nodes: roots[0..count-1] and the nodes of reach managers are updated,
+//every other SddNode* obtained before the call is invalid afterwards (literals and
+//constants excepted); compaction fails while a wmc manager exists or the manager is pinned
+void sdd_manager_compact(SddSize count, SddNode** roots, SddManager* manager);
+//pins keep sdd_manager_compact from running while nodes are held where compaction cannot
+//update them (sdd++ nodes pin their manager)
+void sdd_manager_pin(SddManager* manager);
+void sdd_manager_unpin(SddManager* manager);
+void sdd_manager_set_huge_pages(int mode, SddManager* manager);
+void sdd_manager_set_numa_node(int node, SddManager* manager);
+//spilling pages out the nodes of a vtree held by spill files: those of the last
+//compaction, and those created since for vtrees spilled earlier (other nodes stay in
+//memory until the next compaction)
+void sdd_manager_set_spill_directory(const char* directory, SddManager* manager);
+SddSize sdd_vtree_spill(Vtree* vtree, SddManager* manager);
 
 // MINIMIZATION
 void sdd_manager_minimize(SddManager* manager);
 Vtree* sdd_vtree_minimize(Vtree* vtree, SddManager* manager);
 void sdd_manager_minimize_limited(SddManager* manager);
 Vtree* sdd_vtree_minimize_limited(Vtree* vtree, SddManager* manager);
+Vtree* sdd_vtree_minimize_sift(Vtree* vtree, SddManager* manager);
+Vtree* sdd_vtree_minimize_sift_limited(Vtree* vtree, SddManager* manager);
 
 void sdd_manager_set_vtree_search_convergence_threshold(float threshold, SddManager* manager);
 
@@ -232,6 +296,7 @@ void sdd_manager_set_vtree_apply_time_limit(float time_limit, SddManager* manage
 void sdd_manager_set_vtree_operation_memory_limit(float memory_limit, SddManager* manager);
 void sdd_manager_set_vtree_operation_size_limit(float size_limit, SddManager* manager);
 void sdd_manager_set_vtree_cartesian_product_limit(SddSize size_limit, SddManager* manager);
+void sdd_manager_set_vtree_search_exact_window(SddLiteral var_count, SddManager* manager);
 
 // WMC
 WmcManager* wmc_manager_new(SddNode* node, int log_mode, SddManager* manager);
@@ -244,6 +309,16 @@ SddWmc wmc_literal_weight(const SddLiteral literal, const WmcManager* wmc_manage
 SddWmc wmc_literal_derivative(const SddLiteral literal, const WmcManager* wmc_manager);
 SddWmc wmc_literal_pr(const SddLiteral literal, const WmcManager* wmc_manager);
 
+// REACHABILITY
+ReachManager* reach_manager_new(SddLiteral pair_count, SddLiteral* current_vars, SddLiteral* next_vars, SddSize partition_count, SddNode** partitions, SddManager* manager);
+void reach_manager_free(ReachManager* reach_manager);
+SddNode* reach_image(SddNode* states, ReachManager* reach_manager);
+SddNode* reach_preimage(SddNode* states, ReachManager* reach_manager);
+SddNode* reach_forward(SddNode* init, ReachManager* reach_manager);
+SddNode* reach_backward(SddNode* target, ReachManager* reach_manager);
+SddSize reach_iteration_count(ReachManager* reach_manager);
+ReachStats* reach_stats(ReachManager* reach_manager);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif 
@@ -26,6 +26,8 @@
 #define ERR_MSG_FRG_N "\nerror in %s: fragment cannot be moved to the next state while in goto mode\n"
 #define ERR_MSG_FRG_G "\nerror in %s: fragment cannot by moved to the given state while in next mode\n"
 #define ERR_MSG_FRG_R "\nerror in %s: fragment cannot be rewinded while in goto mode\n"
+#define ERR_MSG_MMAP "\nerror in %s: cannot map memory for a table\n"
+#define ERR_MSG_SHADOW_REFS "\nerror in %s: too many references to a shadow node\n"
 
 //if condition C is met, print error message M that materialized in function F
 #define CHECK_ERROR(C,M,F) if(C) { fprintf(stderr,M,F); exit(1); }
@@ -184,6 +186,19 @@ if(!(C)) {\
   M->auto_local_gc_and_search_on = _mode;\
 }
 
+//ensures that code B of manager M runs with exact reference counts: livelihood changes
+//queued in deferred mode are propagated first, and are not deferred while B runs
+//
+//M: manager
+//B: code
+#define WITH_immediate_refs(M,B) {\
+  int _deferred = M->deferred_refs_on; /* save reference mode */\
+  sdd_manager_flush_deferred_refs(M);\
+  M->deferred_refs_on = 0;\
+  B; /* execute code */\
+  M->deferred_refs_on = _deferred; /* recover reference mode */\
+}
+
 /****************************************************************************************
  * macro for timing code
  ****************************************************************************************/
@@ -14,6 +14,11 @@
 //buckets for storing gc'd nodes according to their size
 #define GC_BUCKETS_COUNT 4
 
+//lists of element arrays abandoned in the compaction array, by size (see basic/memory.c)
+#define COMPACT_FREE_LISTS 16
+//arrays of the list of larger arrays examined by an allocation
+#define COMPACT_FREE_SCAN 8
+
 /****************************************************************************************
  * manager stacks
  ****************************************************************************************/
@@ -21,6 +26,8 @@
 #define INITIAL_SIZE_ELEMENT_STACK 2048
 #define INITIAL_SIZE_COMPRESSION_STACK 2048
 #define INITIAL_SIZE_NODE_BUFFER 2048
+#define INITIAL_SIZE_REF_STACK 2048
+#define INITIAL_SIZE_REPLACEMENT_JOURNAL 1024
 
 /****************************************************************************************
  * hash table parameters (for unique nodes)
@@ -36,6 +43,29 @@
 //number of entries over size that would trigger a decrease of hash size
 #define LOAD_TO_DECREASE_HASH_SIZE 0.05
 
+/****************************************************************************************
+ * shadow arenas
+ ****************************************************************************************/
+
+//bytes of a shadow arena chunk (larger requests get a chunk of their own)
+#define SHADOW_CHUNK_SIZE (64*1024)
+//maximum number of chunks kept by a manager for reuse
+#define MAX_SHADOW_CHUNK_POOL 64
+
+/****************************************************************************************
+ * large tables
+ ****************************************************************************************/
+
+//tables spanning a huge page are mapped in multiples of this size (see basic/tables.c)
+#define HUGE_PAGE_SIZE (2*1024*1024)
+
+//bytes of the sparse spill file holding nodes of spilled vtrees (see basic/memory.c)
+#define SPILL_ARENA_SIZE (((size_t)16)<<30)
+
+//node structures of the first slab; slabs double up to the max (see basic/memory.c)
+#define NODE_SLAB_MIN_COUNT 1024
+#define NODE_SLAB_MAX_COUNT (128*1024)
+
 /****************************************************************************************
  * computation cache parameters
  ****************************************************************************************/
@@ -43,6 +73,28 @@
 //640007, 1280023, 2560021, 5000011
 #define COMPUTED_CACHE_SIZE 2560021
 
+//cache of if-then-else computations (allocated on first use)
+#define ITE_CACHE_SIZE 640007
+
+//cache of sdd_and_exists (allocated on first use)
+#define AND_EXISTS_CACHE_SIZE 262139
+
+//cache of sdd_restrict and sdd_constrain (allocated on first use)
+#define RESTRICT_CACHE_SIZE 262139
+
+//buckets of the local cache of linear constraint construction (see sdds/constraints.c)
+#define LINEAR_CACHE_SIZE 4099
+
+//largest absolute weight of sdd_linear_leq (sums of weights fit in an SddLiteral)
+#define MAX_LINEAR_WEIGHT (((SddLiteral)1)<<31)
+
+/****************************************************************************************
+ * reachability parameters
+ ****************************************************************************************/
+
+//gc between fixpoint iterations when dead nodes exceed this fraction of all nodes
+#define REACH_GC_THRESHOLD 0.25
+
 /****************************************************************************************
  * vtree search options
  ****************************************************************************************/
@@ -56,14 +108,31 @@
 #define VTREE_OP_MEMORY_LIMIT     3.0
 #define INITIAL_CONVERGENCE_THRESHOLD 1.0
 #define CARTESIAN_PRODUCT_LIMIT   8*1024
+#define EXACT_WINDOW_VAR_COUNT    0 //exact window search is opt-in (see tests/bench/bench_exact.c)
 
 //these parameters do not have setter functions
 #define LIMITS_CHECK_FREQUENCY    100
 #define VTREE_OP_SIZE_MIN         16
 #define VTREE_OP_MEMORY_MIN       100.0
+#define EXACT_WINDOW_MAX_VAR_COUNT 10
+#define EXACT_WINDOW_STATE_LIMIT  100000
 
 #define FRAGMENT_SEARCH_BACKWARD 0
 
+//sifting abandons a direction once the size exceeds this factor of the best size
+#define SIFT_MAX_GROWTH 1.2
+
+/****************************************************************************************
+ * vtree cache
+ ****************************************************************************************/
+
+//number of min-hash values in the sketch of a constraint graph
+#define VTREE_CACHE_SKETCH_SIZE 32
+
+//a cached vtree is used for a different fnf only if the sketches of their constraint
+//graphs have at least this fraction of equal values
+#define VTREE_CACHE_MIN_SIMILARITY 0.5
+
 #endif // PARAMETERS_H_
 
 /****************************************************************************************
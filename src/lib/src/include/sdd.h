@@ -110,6 +110,7 @@ typedef struct vtree_t {
   unsigned no_var_in_sdd:1;
   unsigned bit:1;
   unsigned user_bit:1; //for user convenience
+  unsigned spilled:1; //new nodes are allocated in the spill arena (see basic/memory.c)
 } Vtree;
 
 /****************************************************************************************
@@ -147,7 +148,6 @@ typedef struct sdd_node_t {
   SddNodeType type;
   char shadow_type;
   SddNodeSize size; //number of elements for decomposition nodes, 0 for terminal nodes
-  SddNodeSize saved_size; //used for reversing node replacement
   SddRefCount ref_count; //number of parents elements that have non-zero ref_count
   SddRefCount parent_count; //number of parents for node in the SDD DAG
   
@@ -155,7 +155,6 @@ typedef struct sdd_node_t {
 	struct sdd_element_t* elements; // for decompositions
 	SddLiteral literal;             // for literal terminals
   } alpha;
-  struct sdd_element_t* saved_elements; //used for reversing node replacement
 
   struct sdd_node_t* next;  //linking into collision list of hash table  
   struct sdd_node_t** prev; //linking into collision list of hash table
@@ -176,11 +175,28 @@ typedef struct sdd_node_t {
   unsigned cit:1; //used for navigating sdd graphs (should be kept 0 by default)
   unsigned dit:1; //used for multiplying decompositions
   unsigned git:1; //used for garbage collection
+  unsigned rit:1; //references to primes and subs are accounted for (node is live for counts)
+  unsigned qit:1; //queued for deferred reference propagation
   unsigned in_unique_table:1; //used for maintaining counts and sizes
-  unsigned replaced:1; //used for marking rotated or swapped nodes
+  unsigned replaced:1; //replacement of node is on the replacement journal
   unsigned user_bit:1; //for user convenience
 } SddNode;
 
+//array of nodes held by an environment of the manager (e.g., ReachManager): compaction
+//redirects its decomposition nodes to their relocated copies (see basic/compact.c)
+typedef struct sdd_node_registration_t {
+  struct sdd_node_registration_t* next;
+  struct sdd_node_t** nodes;
+  SddSize count;
+} NodeRegistration;
+
+//slab of node structures (see basic/memory.c)
+typedef struct sdd_node_slab_t {
+  struct sdd_node_slab_t* next;
+  struct sdd_node_t* nodes;
+  SddSize count; //node structures in slab
+} NodeSlab;
+
 /****************************************************************************************
  * SDD elements
  ****************************************************************************************/
@@ -190,6 +206,16 @@ typedef struct sdd_element_t {
   SddNode* sub;
 } SddElement;
 
+/****************************************************************************************
+ * journal of reversible node replacements (see basic/replace.c)
+ ****************************************************************************************/
+
+typedef struct sdd_replacement_t {
+  SddNode* node;
+  SddElement* elements; //elements of node before replacement
+  SddNodeSize size; //size of node before replacement
+} SddReplacement;
+
 /****************************************************************************************
  * SDD Computed
  ****************************************************************************************/
@@ -201,6 +227,30 @@ typedef struct sdd_computed_t {
   SddSize id2; //for argument2
 } SddComputed;
 
+//for if-then-else: arguments are not symmetric
+typedef struct sdd_ite_computed_t {
+  struct sdd_node_t* result;
+  SddSize id; //for result
+  SddSize id1; //for if
+  SddSize id2; //for then
+  SddSize id3; //for else
+} SddIteComputed;
+
+//for operations with their own caches (see basic/computed.c)
+typedef struct sdd_op_computed_t {
+  struct sdd_node_t* result;
+  SddSize id; //for result
+  SddSize key1; //for argument1
+  SddSize key2; //for argument2 (and other inputs)
+  SddSize context; //of the call that cached the result
+} SddOpComputed;
+
+typedef struct sdd_op_cache_t {
+  SddOpComputed* table; //allocated on first use
+  SddSize size;
+  SddSize context; //entries of other contexts are invalid
+} SddOpCache;
+
 /****************************************************************************************
  * hash tables for nodes
  ****************************************************************************************/
@@ -238,17 +288,28 @@ typedef struct sdd_node_shadow_t {
   SddSize cache_id;
   Vtree* vtree;
   SddNodeSize size;
-  SddRefCount ref_count;
+  SddRefCount ref_count:30; //bits share the word of ref_count (see MAX_SHADOW_REF_COUNT)
   unsigned bit:1; //used for navigating shadows
   unsigned reuse:1; //used for shadows that require reusing sdd node
 } NodeShadow;
 
+//largest ref_count of a shadow (one per parent element, so bounded by node->parent_count)
+#define MAX_SHADOW_REF_COUNT ((1u<<30)-1)
+
+//chunk of a shadow arena (memory follows the header)
+typedef struct sdd_shadow_chunk_t {
+  struct sdd_shadow_chunk_t* next;
+  size_t size; //bytes of memory
+  size_t used; //bytes handed out
+} ShadowChunk;
+
 typedef struct sdd_shadows_t {
   struct sdd_manager_t* manager;
   SddSize root_count;
   NodeShadow** root_shadows; //roots of the shadow DAG
   SddSize shadow_count;
   SddSize shadow_byte_count;
+  ShadowChunk* chunks; //arena holding all shadows (first chunk is the current one)
   unsigned bit:1; //current value of shadow bit
 } SddShadows;
 
@@ -341,6 +402,7 @@ typedef struct sdd_manager_vtree_ops_t {
   char current_op;
   float convergence_threshold;
   SddSize cartesian_product_limit;
+  SddLiteral exact_window_var_count; //0 if exact search is off
 } SddManagerVtreeOps;
 
 typedef struct sdd_manager_t {
@@ -352,6 +414,7 @@ typedef struct sdd_manager_t {
   SddSize node_count; //dead + live
   SddSize dead_node_count; 
   SddSize computed_count; 
+  SddSize ite_computed_count;
   
   //size of sdds
   SddSize sdd_size; //dead + live
@@ -363,6 +426,38 @@ typedef struct sdd_manager_t {
 
   //linked lists of free structures (linked through next)
   SddNode** gc_node_lists; //buckets of linked lists
+  
+  //placement of large tables (see basic/tables.c)
+  int huge_pages; //0: regular pages, 1: transparent huge pages, 2: explicit huge pages
+  int numa_node; //preferred numa node of large tables (-1 if none)
+  
+  char* spill_directory; //where spill files are created (NULL if none)
+  
+  //slabs holding the node structures of decomposition nodes (see basic/memory.c)
+  NodeSlab* node_slabs; //first slab is the current one
+  SddSize node_slab_used; //node structures handed out from the current slab
+  
+  //arrays holding the nodes and elements relocated by the last compaction
+  SddNode* compact_nodes;
+  SddSize compact_node_count;
+  SddElement* compact_elements;
+  SddSize compact_element_count;
+  int compact_spilled; //arrays are mapped from a spill file
+  NodeRegistration* node_registrations; //node arrays redirected by compaction
+  SddSize wmc_manager_count; //compaction is refused while wmc managers exist
+  SddSize pin_count; //compaction is refused while pinned (see sdd_manager_pin)
+  SddElement* compact_free_elements[COMPACT_FREE_LISTS]; //freed element arrays of compact storage
+  char* spill_arena; //nodes and elements of spilled vtrees since the last compaction
+  size_t spill_arena_used; //bytes handed out from the spill arena
+  
+  //chunks kept for reuse by shadow arenas (see basic/shadows.c)
+  ShadowChunk* shadow_chunks;
+  SddSize shadow_chunk_count;
+  
+  //incremental garbage collection
+  SddSize gc_step_budget; //budget of the gc step taken after each top-level apply (0 if off)
+  Vtree* gc_step_vtree; //vtree node where the current sweep resumes (NULL: start a new sweep)
+  SddNode* gc_step_node; //node of gc_step_vtree where the current sweep resumes (NULL: done with vtree node)
  
   struct vtree_t* vtree;
   SddNode* true_sdd;
@@ -371,6 +466,7 @@ typedef struct sdd_manager_t {
   //indexing literal sdds and leaf vtrees
   struct sdd_node_t** literals; //array of literals
   struct vtree_t** leaf_vtrees; //array of leaf vtrees
+  SddSize* var_holds; //holds on variables, indexed by var (see manager/variables.c)
 
   //unique_nodes
   SddHash* unique_nodes;
@@ -380,6 +476,9 @@ typedef struct sdd_manager_t {
   SddSize computed_cache_hit_count;
   SddComputed* conjoin_cache;
   SddComputed* disjoin_cache;
+  SddIteComputed* ite_cache;
+  SddOpCache and_exists_cache;
+  SddOpCache restrict_cache; //restrict and constrain
   
   //apply
   SddLiteral apply_depth; //depth of apply call (1 means top-level apply)
@@ -418,6 +517,22 @@ typedef struct sdd_manager_t {
   //buffer for sorting nodes
   SddNode** node_buffer;
   SddSize node_buffer_size;
+  
+  //worklist for propagating reference counts
+  SddNode** top_ref_stack;
+  SddNode** start_ref_stack;
+  SddSize capacity_ref_stack;
+  
+  //nodes whose livelihood changed while references were deferred
+  SddNode** top_deferred_ref_stack;
+  SddNode** start_deferred_ref_stack;
+  SddSize capacity_deferred_ref_stack;
+  //journal of reversible node replacements made by the current vtree operation
+  SddReplacement* top_replacement_journal;
+  SddReplacement* start_replacement_journal;
+  SddSize capacity_replacement_journal;
+  
+  int deferred_refs_on; //livelihood changes are queued instead of propagated
 
   //general options for manager 
   void* options;
@@ -447,6 +562,12 @@ typedef struct sdd_manager_t {
   int auto_search_invocation_count_aborted_search; //number of aborted auto searches (search limits)
   int auto_search_iteration_count; //number of iterations (passes) per search
   float auto_search_reduction_sum; //sum of percentage size reduction over all searches
+  char auto_search_policy; //'f' (fixed growth thresholds) or 'g' (adaptive growth thresholds)
+  float auto_global_growth; //growth thresholds of policy 'g'
+  float auto_local_growth;
+  float auto_apply_growth;
+  clock_t auto_apply_time; //time in top-level applies (excluding searches) since the last top-level search (policy 'g')
+  clock_t auto_search_time_mark; //stats.auto_search_time after the last top-level search (policy 'g')
   
   //fragments
   SddSize max_fragment_shadow_count; //maximum number of shadows constructed by any fragment
@@ -494,6 +615,32 @@ typedef struct wmc_manager_t {
   SddManager* sdd_manager;
 } WmcManager;
 
+/****************************************************************************************
+ * ReachManager
+ *
+ * An environment for computing reachable states of a transition system
+ *
+ ****************************************************************************************/
+
+//statistics of one fixpoint iteration (defined in the api, sdd/sdd.h)
+typedef struct reach_stats_t ReachStats;
+
+typedef struct reach_manager_t {
+  SddLiteral pair_count;
+  SddLiteral* current_vars; //current_vars[i] is paired with next_vars[i]
+  SddLiteral* next_vars;
+  SddLiteral var_count; //of the sdd manager when the maps below were built
+  SddLiteral* rename_map; //swaps current and next variables
+  SddSize partition_count;
+  SddNode** partitions; //referenced
+  int** image_maps; //image_maps[i]: current variables quantified with partitions[i]
+  int** preimage_maps; //preimage_maps[i]: next variables quantified with partitions[i]
+  SddSize iteration_count; //of last fixpoint
+  SddSize stats_capacity;
+  ReachStats* stats; //of last fixpoint
+  SddManager* sdd_manager;
+} ReachManager;
+
 /****************************************************************************************
  * SatManager
  *
@@ -543,9 +690,30 @@ int verify_X_constrained(const Vtree* vtree);
 //computed.c
 SddNode* lookup_computation(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager);
 void cache_computation(SddNode* node1, SddNode* node2, SddNode* node, BoolOp op, SddManager* manager);
+SddNode* lookup_ite_computation(SddNode* f, SddNode* g, SddNode* h, SddManager* manager);
+void cache_ite_computation(SddNode* f, SddNode* g, SddNode* h, SddNode* node, SddManager* manager);
+void init_op_cache(SddSize size, SddOpCache* cache);
+void free_op_cache(SddOpCache* cache);
+void new_op_context(SddOpCache* cache);
+SddNode* lookup_op_computation(SddSize key1, SddSize key2, SddOpCache* cache, SddManager* manager);
+void cache_op_computation(SddSize key1, SddSize key2, SddNode* node, SddOpCache* cache, SddManager* manager);
+
+//compact.c
+void sdd_manager_compact(SddSize count, SddNode** roots, SddManager* manager);
+void register_nodes(SddNode** nodes, SddSize count, SddManager* manager);
+void unregister_nodes(SddNode** nodes, SddManager* manager);
+void sdd_manager_pin(SddManager* manager);
+void sdd_manager_unpin(SddManager* manager);
+SddSize sdd_vtree_spill(Vtree* vtree, SddManager* manager);
+
+//tables.c
+void sdd_manager_set_huge_pages(int mode, SddManager* manager);
+void sdd_manager_set_numa_node(int node, SddManager* manager);
+void sdd_manager_set_spill_directory(const char* directory, SddManager* manager);
 
 //gc.c
 void sdd_vtree_garbage_collect(Vtree* vtree, SddManager* manager);
+int sdd_manager_gc_step(SddSize budget, SddManager* manager);
 
 //hash.c
 float hit_rate(SddHash* hash);
@@ -556,6 +724,10 @@ float saturation(SddHash* hash);
 SddRefCount sdd_ref_count(SddNode* node);
 SddNode* sdd_ref(SddNode* node, SddManager* manager);
 SddNode* sdd_deref(SddNode* node, SddManager* manager);
+void sdd_manager_flush_deferred_refs(SddManager* manager);
+void sdd_manager_deferred_refs_on(SddManager* manager);
+void sdd_manager_deferred_refs_off(SddManager* manager);
+int sdd_manager_is_deferred_refs_on(SddManager* manager);
 
 //sort.c
 void sort_linked_nodes(SddSize count, SddNode** list, SddManager* manager);
@@ -577,6 +749,7 @@ void declare_interrupt_signal();
 void sdd_manager_auto_gc_and_minimize_on(SddManager* manager);
 void sdd_manager_auto_gc_and_minimize_off(SddManager* manager);
 int sdd_manager_is_auto_gc_and_minimize_on(SddManager* manager);
+void sdd_manager_set_gc_step_budget(SddSize budget, SddManager* manager);
 SddLiteral sdd_manager_var_count(SddManager* manager);
 SddSize sdd_manager_size(const SddManager* manager);
 SddSize sdd_manager_live_size(const SddManager* manager);
@@ -603,11 +776,15 @@ void sdd_manager_add_var_before(SddLiteral target_var, SddManager* manager);
 void sdd_manager_add_var_after(SddLiteral target_var, SddManager* manager);
 void add_var_before_lca(int count, SddLiteral* variables, SddManager* manager);
 void add_var_after_lca(int count, SddLiteral* variables, SddManager* manager);
+void sdd_manager_add_vars(SddLiteral count, char location, SddLiteral target_var, SddManager* manager);
 void move_var_before_first(SddLiteral var, SddManager* manager);
 void move_var_after_last(SddLiteral var, SddManager* manager);
 void move_var_before(SddLiteral var, SddLiteral target_var, SddManager* manager);
 void move_var_after(SddLiteral var, SddLiteral target_var, SddManager* manager);
 void remove_var_added_last(SddManager* manager);
+void sdd_manager_hold_var(SddLiteral var, SddManager* manager);
+void sdd_manager_release_var(SddLiteral var, SddManager* manager);
+SddLiteral sdd_manager_remove_unused_vars(SddLiteral* renumber_map, SddManager* manager);
 
 //
 //vtree_ops
@@ -643,10 +820,18 @@ Vtree* vtree_fragment_rewind(VtreeFragment* fragment);
 //vtree search
 //
 
+//auto.c
+void sdd_manager_set_auto_search_policy(char policy, SddManager* manager);
+float sdd_manager_auto_search_growth(char threshold, SddManager* manager);
+
 //search.c
 Vtree* sdd_vtree_minimize(Vtree* vtree, SddManager* manager);
 Vtree* sdd_vtree_minimize_limited(Vtree* vtree, SddManager* manager);
 
+//sift.c
+Vtree* sdd_vtree_minimize_sift(Vtree* vtree, SddManager* manager);
+Vtree* sdd_vtree_minimize_sift_limited(Vtree* vtree, SddManager* manager);
+
 //
 //fnf
 //
@@ -670,6 +855,15 @@ void print_dnf(FILE* file, const Dnf* dnf);
 //vtree.c
 void minimize_vtree_width(Fnf* fnf, Vtree** vtree_loc);
 
+//structured.c
+Vtree* sdd_vtree_new_from_fnf(Fnf* fnf, const char* method);
+void fnf_of_clauses(SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses, Fnf* fnf);
+
+//cache.c
+char* fnf_fingerprint(Fnf* fnf);
+Vtree* sdd_vtree_cache_read(const char* directory, Fnf* fnf);
+int sdd_vtree_cache_save(const char* directory, Fnf* fnf, Vtree* vtree);
+
 
 //
 //sdd
@@ -678,6 +872,7 @@ void minimize_vtree_width(Fnf* fnf, Vtree** vtree_loc);
 //apply.c
 SddNode* sdd_apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager);
 SddNode* sdd_negate(SddNode* node, SddManager* manager);
+SddNode* sdd_ite(SddNode* node1, SddNode* node2, SddNode* node3, SddManager* manager);
 
 //bits.c
 void sdd_clear_node_bits(SddNode* node);
@@ -689,11 +884,35 @@ SddSize sdd_count_multiple_parent_nodes_to_leaf(SddNode* node, Vtree* leaf);
 SddLiteral sdd_minimum_cardinality(SddNode* node);
 SddNode* sdd_minimize_cardinality(SddNode* node, SddManager* manager);
 
+//and_exists.c
+SddNode* sdd_and_exists(SddNode* node1, SddNode* node2, int* exists_map, SddManager* manager);
+
+//compose.c
+SddNode* sdd_compose(SddNode* node, SddLiteral var, SddNode* g, SddManager* manager);
+SddNode* sdd_vector_compose(SddNode* node, SddNode** compose_map, SddManager* manager);
+
+//constraints.c
+SddNode* sdd_at_most_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager);
+SddNode* sdd_at_least_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager);
+SddNode* sdd_exactly_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager);
+SddNode* sdd_linear_leq(SddLiteral* weights, SddLiteral bound, SddManager* manager);
+SddNode* sdd_parity(SddLiteral count, SddLiteral* vars, SddManager* manager);
+
+//quantify.c
+SddNode* sdd_forall_multiple(int* forall_map, SddNode* node, SddManager* manager);
+SddNode* sdd_quantify_prefix(SddSize block_count, const char* quantifiers, SddSize* var_blocks, SddNode* node, SddManager* manager);
+
+//restrict.c
+SddNode* sdd_restrict(SddNode* node, SddNode* care, SddManager* manager);
+SddNode* sdd_constrain(SddNode* node, SddNode* care, SddManager* manager);
+
 //condition.c
 SddNode* sdd_condition(SddLiteral lit, SddNode* node, SddManager* manager);
 
 //copy.c
 SddNode* sdd_copy(SddNode* node, SddManager* dest_manager);
+SddNode* sdd_transfer(SddNode* node, SddManager* dest_manager);
+void sdd_transfer_multiple(SddSize count, SddNode** nodes, SddNode** transfers, SddManager* dest_manager);
 
 //exists.c
 SddNode* sdd_exists(SddLiteral var, SddNode* node, SddManager* manager);
@@ -739,6 +958,16 @@ SddWmc literal_weight(const SddLiteral literal, const WmcManager* wmc_manager);
 SddWmc wmc_literal_derivative(const SddLiteral literal, const WmcManager* wmc_manager);
 SddWmc wmc_literal_pr(const SddLiteral literal, const WmcManager* wmc_manager);
 
+//reachability.c
+ReachManager* reach_manager_new(SddLiteral pair_count, SddLiteral* current_vars, SddLiteral* next_vars, SddSize partition_count, SddNode** partitions, SddManager* manager);
+void reach_manager_free(ReachManager* reach_manager);
+SddNode* reach_image(SddNode* states, ReachManager* reach_manager);
+SddNode* reach_preimage(SddNode* states, ReachManager* reach_manager);
+SddNode* reach_forward(SddNode* init, ReachManager* reach_manager);
+SddNode* reach_backward(SddNode* target, ReachManager* reach_manager);
+SddSize reach_iteration_count(ReachManager* reach_manager);
+ReachStats* reach_stats(ReachManager* reach_manager);
+
 //
 //vtree
 //
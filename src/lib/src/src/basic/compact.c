@@ -0,0 +1,273 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//basic/computed.c
+void relocate_computed(SddManager* manager);
+
+//basic/hash.c
+void insert_sdd_node(SddNode* node, SddHash* hash, SddManager* manager);
+
+//basic/memory.c
+int in_compact_nodes(SddNode* node, SddManager* manager);
+void free_node_slabs(SddManager* manager);
+int in_compact_elements(SddElement* elements, SddManager* manager);
+int in_spill_arena(void* p, SddManager* manager);
+
+//basic/nodes.c
+void free_sdd_node(SddNode* node, SddManager* manager);
+
+//basic/tables.c
+void* new_table(SddSize count, size_t size, SddManager* manager);
+void free_table(void* table, SddSize count, size_t size);
+void* new_spill_table(SddSize count, size_t size, SddManager* manager);
+void free_spill_table(void* table, SddSize count, size_t size);
+void spill_range(void* start, void* end);
+void free_spill_arena(void* arena);
+
+/****************************************************************************************
+ * compaction
+ *
+ * after a global gc, the nodes of the unique table are copied into one fresh array of
+ * nodes, and their elements into one fresh array of elements, in vtree post-order:
+ * nodes of a vtree node come after the nodes of its descendants, so the primes and subs
+ * of a node are placed before it (topological order)
+ *
+ * the gc lists are emptied and every original node structure is freed, together with the
+ * node slabs (see memory.c for how structures inside slabs and compaction arrays are
+ * handled)
+ *
+ * ids, reference counts and parent counts are preserved, so the unique table is rebuilt
+ * with the same hash keys and computed results are redirected to the copies
+ *
+ * terminal sdds (constants and literals) are not relocated
+ *
+ * besides the roots passed by the caller, only node arrays registered with the manager
+ * (register_nodes) are redirected to the copies: environments of the manager that hold
+ * nodes register them (ReachManager). wmc managers index their nodes in ways that cannot
+ * be redirected, so compaction is refused while one exists, and while the manager is
+ * pinned by holders of individual nodes (sdd++ nodes)
+ *
+ * if a spill directory is set, the arrays are mapped from a spill file (basic/tables.c)
+ ****************************************************************************************/
+
+//nodes[0..count-1] will be redirected by compaction until unregistered
+//(the array must stay in place while registered)
+void register_nodes(SddNode** nodes, SddSize count, SddManager* manager) {
+  NodeRegistration* registration;
+  MALLOC(registration,NodeRegistration,"register_nodes");
+  registration->nodes = nodes;
+  registration->count = count;
+  registration->next  = manager->node_registrations;
+  manager->node_registrations = registration;
+}
+
+void unregister_nodes(SddNode** nodes, SddManager* manager) {
+  NodeRegistration** loc = &(manager->node_registrations);
+  while(*loc && (*loc)->nodes!=nodes) loc = &((*loc)->next);
+  assert(*loc);
+  NodeRegistration* registration = *loc;
+  *loc = registration->next;
+  free(registration);
+}
+
+void sdd_manager_pin(SddManager* manager) {
+  ++manager->pin_count;
+}
+
+void sdd_manager_unpin(SddManager* manager) {
+  CHECK_ERROR(manager->pin_count==0,"\nerror in %s: more unpins than pins of a manager\n","sdd_manager_unpin");
+  --manager->pin_count;
+}
+
+//frees the arrays of the last compaction and the spill arena (the nodes they hold must be
+//freed first)
+void free_compact_arrays(SddManager* manager) {
+  if(manager->compact_spilled) {
+    free_spill_table(manager->compact_nodes,manager->compact_node_count,sizeof(SddNode));
+    free_spill_table(manager->compact_elements,manager->compact_element_count,sizeof(SddElement));
+  }
+  else {
+    free_table(manager->compact_nodes,manager->compact_node_count,sizeof(SddNode));
+    free_table(manager->compact_elements,manager->compact_element_count,sizeof(SddElement));
+  }
+  for(int i=0; i<COMPACT_FREE_LISTS; i++) manager->compact_free_elements[i] = NULL;
+  free_spill_arena(manager->spill_arena);
+  manager->spill_arena      = NULL;
+  manager->spill_arena_used = 0;
+}
+
+static
+void copy_nodes_of(Vtree* vtree, SddNode** node_loc, SddElement** element_loc) {
+  if(LEAF(vtree)) return;
+  copy_nodes_of(vtree->left,node_loc,element_loc);
+  copy_nodes_of(vtree->right,node_loc,element_loc);
+  FOR_each_sdd_node_normalized_for(node,vtree,{
+    SddNode* copy     = (*node_loc)++;
+    SddElement* elements = *element_loc;
+    *element_loc     += node->size;
+    *copy             = *node;
+    copy->map         = NULL;
+    ELEMENTS_OF(copy) = elements;
+    memcpy(elements,ELEMENTS_OF(node),node->size*sizeof(SddElement));
+    node->map         = copy;
+  });
+}
+
+//the pointers of copies still point to original nodes: redirect them to copies
+static
+void redirect_copy(SddNode* copy) {
+  SddElement* e = ELEMENTS_OF(copy);
+  for(SddNodeSize i=0; i<copy->size; i++, e++) {
+    if(IS_DECOMPOSITION(e->prime)) e->prime = e->prime->map;
+    if(IS_DECOMPOSITION(e->sub))   e->sub   = e->sub->map;
+  }
+  if(copy->negation) copy->negation = copy->negation->map;
+  if(copy->vtree_next) copy->vtree_next = copy->vtree_next->map;
+}
+
+//relocates all nodes of the unique table into contiguous storage; dead nodes are gc'd
+//
+//roots[0..count-1] and registered nodes are replaced by their relocated copies; any
+//other pointer to a decomposition node held outside the manager is invalid after the call
+void sdd_manager_compact(SddSize count, SddNode** roots, SddManager* manager) {
+  CHECK_ERROR(manager->apply_depth,"\nerror in %s: cannot compact during an apply\n","sdd_manager_compact");
+  CHECK_ERROR(manager->wmc_manager_count,"\nerror in %s: cannot compact while a wmc manager exists\n","sdd_manager_compact");
+  CHECK_ERROR(manager->pin_count,"\nerror in %s: cannot compact while the manager is pinned\n","sdd_manager_compact");
+  for(SddSize i=0; i<count; i++) CHECK_ERROR(GC_NODE(roots[i]),ERR_MSG_GC,"sdd_manager_compact");
+
+  sdd_vtree_garbage_collect(manager->vtree,manager); //flushes deferred references
+
+  SddHash* hash         = manager->unique_nodes;
+  SddSize node_count    = hash->count;
+  SddSize element_count = 0;
+  FOR_each_unique_node(n,manager,element_count += n->size);
+
+  int spilled = manager->spill_directory!=NULL;
+  SddNode* nodes;
+  SddElement* elements;
+  if(spilled) {
+    nodes    = new_spill_table(node_count,sizeof(SddNode),manager);
+    elements = new_spill_table(element_count,sizeof(SddElement),manager);
+  }
+  else {
+    nodes    = new_table(node_count,sizeof(SddNode),manager);
+    elements = new_table(element_count,sizeof(SddElement),manager);
+  }
+
+  //copy nodes and elements (original nodes point to their copies via ->map)
+  SddNode* node_loc       = nodes;
+  SddElement* element_loc = elements;
+  copy_nodes_of(manager->vtree,&node_loc,&element_loc);
+  assert(node_loc==nodes+node_count);
+  assert(element_loc==elements+element_count);
+
+  for(SddNode* copy=nodes; copy<node_loc; copy++) redirect_copy(copy);
+  FOR_each_internal_vtree_node(v,manager->vtree,{ //relink node lists of vtree nodes
+    if(v->nodes) v->nodes = v->nodes->map;
+    SddNode** prev = &(v->nodes);
+    FOR_each_sdd_node_normalized_for(n,v,{
+      n->vtree_prev = prev;
+      prev = &(n->vtree_next);
+    });
+  });
+  relocate_computed(manager);
+  new_op_context(&manager->and_exists_cache); //results moved
+  new_op_context(&manager->restrict_cache);
+  for(SddSize i=0; i<count; i++) if(IS_DECOMPOSITION(roots[i])) roots[i] = roots[i]->map;
+  for(NodeRegistration* r=manager->node_registrations; r; r=r->next) {
+    for(SddSize i=0; i<r->count; i++) if(IS_DECOMPOSITION(r->nodes[i])) r->nodes[i] = r->nodes[i]->map;
+  }
+
+  //free original nodes and empty the gc lists
+  FOR_each_unique_node(n,manager,free_sdd_node(n,manager));
+  for(int i=0; i<GC_BUCKETS_COUNT; i++) {
+    SddNode* list = manager->gc_node_lists[i];
+    FOR_each_linked_node(node,list,free_sdd_node(node,manager));
+    manager->gc_node_lists[i] = NULL;
+  }
+  manager->gc_node_count    = 0;
+  manager->gc_element_count = 0;
+  free_node_slabs(manager); //holds no node structure in use now
+
+  //free arrays of last compaction (no longer used) and adopt the new ones
+  free_compact_arrays(manager);
+  manager->compact_spilled       = spilled;
+  manager->compact_nodes         = nodes;
+  manager->compact_node_count    = node_count;
+  manager->compact_elements      = elements;
+  manager->compact_element_count = element_count;
+  manager->stats.element_count  += element_count;
+  manager->stats.max_element_count = MAX(manager->stats.max_element_count,manager->stats.element_count);
+
+  //rebuild unique table
+  memset(hash->clists,0,hash->size*sizeof(SddNode*));
+  hash->count = 0;
+  for(SddNode* copy=nodes; copy<node_loc; copy++) insert_sdd_node(copy,hash,manager);
+
+  //the incremental gc sweep may have stopped at an original node
+  manager->gc_step_vtree = NULL;
+  manager->gc_step_node  = NULL;
+
+  assert(!FULL_DEBUG || verify_counts_and_sizes(manager));
+  assert(!FULL_DEBUG || verify_negations(manager));
+}
+
+/****************************************************************************************
+ * spilling
+ *
+ * compaction places the nodes (and elements) of a vtree after those of its descendants,
+ * so the nodes of a vtree and its descendants occupy one range of each compaction array
+ * (minus nodes gc'd since, whose structures stay in place)
+ *
+ * spilling a vtree pages these ranges out; they are paged back in on access. if a spill
+ * directory is set, the vtree and its descendants are marked as spilled, so nodes created
+ * for them later are placed in the spill arena (see basic/memory.c); the range of the
+ * arena holding nodes of the vtree is paged out as well (it may hold other spilled nodes).
+ * other nodes allocated since the last compaction (in node slabs) are not affected, nor
+ * counted
+ ****************************************************************************************/
+
+//extends [*first,*last) to include [start,end)
+static inline
+void extend_range(void* start, void* end, char** first, char** last) {
+  if(*first==NULL || (char*) start<*first) *first = start;
+  if(*last==NULL  || (char*) end>*last)    *last  = end;
+}
+
+//returns the number of nodes of vtree and its descendants whose storage was paged out
+SddSize sdd_vtree_spill(Vtree* vtree, SddManager* manager) {
+  char* nodes[2]    = {NULL,NULL}; //range in compact_nodes
+  char* elements[2] = {NULL,NULL}; //range in compact_elements
+  char* arena[2]    = {NULL,NULL}; //range in the spill arena
+  SddSize count     = 0;
+
+  if(manager->spill_directory) FOR_each_vtree_node(v,vtree,v->spilled = 1);
+
+  FOR_each_decomposition_in(n,vtree,{
+    SddElement* e = ELEMENTS_OF(n);
+    if(in_compact_nodes(n,manager)) {
+      ++count;
+      extend_range(n,n+1,nodes,nodes+1);
+    }
+    else if(in_spill_arena(n,manager)) {
+      ++count;
+      extend_range(n,n+1,arena,arena+1);
+    }
+    if(in_compact_elements(e,manager)) extend_range(e,e+n->size,elements,elements+1);
+    else if(in_spill_arena(e,manager)) extend_range(e,e+n->size,arena,arena+1);
+  });
+
+  if(nodes[0]) spill_range(nodes[0],nodes[1]);
+  if(elements[0]) spill_range(elements[0],elements[1]);
+  if(arena[0]) spill_range(arena[0],arena[1]);
+  return count;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -6,10 +6,15 @@
 
 #include "sdd.h"
 
+//basic/tables.c
+void* new_table(SddSize count, size_t size, SddManager* manager);
+void free_table(void* table, SddSize count, size_t size);
+
 /****************************************************************************************
  * computation cache
  *
- * there are two hash tables for caching computations, one for conjoin and one for disjoin
+ * there are two hash tables for caching computations, one for conjoin and one for disjoin,
+ * and a third one for if-then-else computations (three arguments)
  *
  * there are no collision lists in these hash tables: just one entry (similar to CUDD)
  *
@@ -86,6 +91,138 @@ SddNode* lookup_computation(SddNode* node1, SddNode* node2, BoolOp op, SddManage
   else return NULL; //miss: non-matching computed for this key
 }
  
+/****************************************************************************************
+ * if-then-else: save and lookup
+ ****************************************************************************************/
+
+static inline
+SddSize ite_hash_key(SddNode* f, SddNode* g, SddNode* h) {
+  return ((16777619*((16777619*f->id)^(g->id)))^(h->id)) % ITE_CACHE_SIZE;
+}
+
+void cache_ite_computation(SddNode* f, SddNode* g, SddNode* h, SddNode* node, SddManager* manager) {
+  assert(!GC_NODE(node) && !GC_NODE(f) && !GC_NODE(g) && !GC_NODE(h));
+  assert(NON_TRIVIAL(f) && NON_TRIVIAL(g) && NON_TRIVIAL(h));
+
+  if(manager->ite_cache==NULL) manager->ite_cache = new_table(ITE_CACHE_SIZE,sizeof(SddIteComputed),manager);
+  SddIteComputed* computed = manager->ite_cache+ite_hash_key(f,g,h);
+
+  if(computed->result!=NULL) --manager->ite_computed_count; //override current computed
+  ++manager->ite_computed_count;
+
+  computed->result = node;
+  computed->id     = node->id; //needed to check whether result has been gc'd
+  computed->id1    = f->id;
+  computed->id2    = g->id;
+  computed->id3    = h->id;
+}
+
+SddNode* lookup_ite_computation(SddNode* f, SddNode* g, SddNode* h, SddManager* manager) {
+  assert(!GC_NODE(f) && !GC_NODE(g) && !GC_NODE(h));
+  assert(NON_TRIVIAL(f) && NON_TRIVIAL(g) && NON_TRIVIAL(h));
+
+  ++manager->computed_cache_lookup_count;
+
+  if(manager->ite_cache==NULL) return NULL; //nothing cached yet
+  SddIteComputed* computed = manager->ite_cache+ite_hash_key(f,g,h);
+  if(computed->result==NULL) return NULL; //missing computed
+  else if(computed->id!=computed->result->id) return NULL; //invalid
+  else if(computed->id1==f->id && computed->id2==g->id && computed->id3==h->id) {
+    ++manager->computed_cache_hit_count; //found it
+    return computed->result; //hit
+  }
+  else return NULL; //miss: non-matching computed for this key
+}
+
+/****************************************************************************************
+ * caches of other operations (and_exists, restrict/constrain)
+ *
+ * one table per operation, kept by the manager and allocated when the operation is first
+ * used. an entry is keyed by two numbers (node ids, possibly combined with other inputs)
+ * and validated by the id of its result, as above
+ *
+ * results may also depend on inputs that are not keys (e.g., the quantified variables),
+ * so an entry saves the context of the call that cached it: an operation starts a new
+ * context when results of earlier calls may no longer apply, which invalidates all
+ * entries without touching the table. compaction starts a new context for every
+ * operation, as it moves the results
+ ****************************************************************************************/
+
+void init_op_cache(SddSize size, SddOpCache* cache) {
+  cache->table   = NULL;
+  cache->size    = size;
+  cache->context = 1; //entries of a zeroed table have context 0
+}
+
+void free_op_cache(SddOpCache* cache) {
+  free_table(cache->table,cache->size,sizeof(SddOpComputed));
+  cache->table = NULL;
+}
+
+void new_op_context(SddOpCache* cache) {
+  ++cache->context;
+}
+
+static inline
+SddOpComputed* op_computed(SddSize key1, SddSize key2, SddOpCache* cache, SddManager* manager) {
+  if(cache->table==NULL) cache->table = new_table(cache->size,sizeof(SddOpComputed),manager);
+  return cache->table+((16777619*key1)^key2) % cache->size;
+}
+
+SddNode* lookup_op_computation(SddSize key1, SddSize key2, SddOpCache* cache, SddManager* manager) {
+  SddOpComputed* computed = op_computed(key1,key2,cache,manager);
+  if(computed->context!=cache->context) return NULL; //missing computed, or of another context
+  else if(computed->id!=computed->result->id) return NULL; //invalid computed
+  else if(computed->key1==key1 && computed->key2==key2) return computed->result; //hit
+  else return NULL; //miss: non-matching computed for this key
+}
+
+void cache_op_computation(SddSize key1, SddSize key2, SddNode* node, SddOpCache* cache, SddManager* manager) {
+  assert(!GC_NODE(node));
+  SddOpComputed* computed = op_computed(key1,key2,cache,manager);
+  computed->result  = node;
+  computed->id      = node->id; //needed to check whether result has been gc'd
+  computed->key1    = key1;
+  computed->key2    = key2;
+  computed->context = cache->context;
+}
+
+/****************************************************************************************
+ * relocation
+ ****************************************************************************************/
+
+//called by sdd_manager_compact() after every unique node n has been copied into n->map
+//(and before the original nodes are freed): valid results are redirected to their copies
+void relocate_computed(SddManager* manager) {
+  SddComputed* tables[2] = { manager->conjoin_cache, manager->disjoin_cache };
+  for(int i=0; i<2; i++) {
+    SddComputed* computed = tables[i];
+    for(SddSize j=0; j<COMPUTED_CACHE_SIZE; j++, computed++) {
+      SddNode* result = computed->result;
+      if(result==NULL || !IS_DECOMPOSITION(result)) continue; //terminal results do not move
+      if(computed->id!=result->id) delete_computed(computed,manager); //invalid
+      else {
+        assert(result->in_unique_table && result->map);
+        computed->result = result->map;
+      }
+    }
+  }
+  SddIteComputed* computed = manager->ite_cache;
+  if(computed==NULL) return; //not allocated yet
+  for(SddSize j=0; j<ITE_CACHE_SIZE; j++, computed++) {
+    SddNode* result = computed->result;
+    if(result==NULL || !IS_DECOMPOSITION(result)) continue; //terminal results do not move
+    if(computed->id!=result->id) {
+      --manager->ite_computed_count; //invalid
+      computed->result = NULL;
+    }
+    else {
+      assert(result->in_unique_table && result->map);
+      computed->result = result->map;
+    }
+  }
+}
+
 /****************************************************************************************
  * end
  ****************************************************************************************/
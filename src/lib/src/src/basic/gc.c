@@ -91,7 +91,9 @@ void garbage_collect_in(Vtree* vtree, SddManager* manager) {
 }
 
 //visit nodes top-down: when a node is gc'd, it must have no parents
+//deferred reference changes are flushed first so that dead nodes are identified exactly
 void sdd_vtree_garbage_collect(Vtree* vtree, SddManager* manager) {
+  sdd_manager_flush_deferred_refs(manager);
   mark_gc_nodes(vtree);
   garbage_collect_above(vtree,manager);
   garbage_collect_in(vtree,manager);
@@ -99,6 +101,63 @@ void sdd_vtree_garbage_collect(Vtree* vtree, SddManager* manager) {
   assert(!FULL_DEBUG || verify_gc(vtree,manager));
 }
 
+/****************************************************************************************
+ * incremental garbage collection
+ *
+ * a sweep visits the vtree nodes in pre-order (parents before children) and gc's each
+ * dead node that has no parents; a step resumes the current sweep where the previous
+ * step stopped and visits at most budget vtree and sdd nodes, so the pause is bounded
+ *
+ * the sweep position (gc_step_vtree, gc_step_node) survives applies: remove_from_unique_table
+ * advances gc_step_node when that node leaves the unique table, and removing a variable
+ * from the vtree restarts the sweep
+ *
+ * as with sdd_manager_garbage_collect, every node to be kept must be referenced
+ ****************************************************************************************/
+
+//next vtree node in pre-order, NULL if vtree is the last one
+static
+Vtree* next_vtree_in_preorder(Vtree* vtree) {
+  if(INTERNAL(vtree)) return vtree->left;
+  while(vtree->parent && vtree==vtree->parent->right) vtree = vtree->parent;
+  return vtree->parent? vtree->parent->right: NULL;
+}
+
+//returns 1 if the current sweep was completed by this step, 0 otherwise
+int sdd_manager_gc_step(SddSize budget, SddManager* manager) {
+  sdd_manager_flush_deferred_refs(manager);
+  
+  if(manager->gc_step_vtree==NULL) { //start a new sweep
+    manager->gc_step_vtree = manager->vtree;
+    manager->gc_step_node  = INTERNAL(manager->vtree)? manager->vtree->nodes: NULL;
+  }
+  
+  while(budget) {
+    Vtree* vtree = manager->gc_step_vtree;
+    if(vtree->dead_node_count==0) manager->gc_step_node = NULL; //skip node list
+    while(budget && manager->gc_step_node) {
+      SddNode* node = manager->gc_step_node;
+      manager->gc_step_node = node->vtree_next; //advance before node is gc'd
+      if(node->ref_count==0 && node->parent_count==0) {
+        remove_from_unique_table(node,manager); //first
+        gc_sdd_node(node,manager); //second
+      }
+      --budget;
+    }
+    if(manager->gc_step_node) return 0; //budget exhausted inside node list
+    if(budget) --budget; //visiting a vtree node
+    vtree = next_vtree_in_preorder(vtree);
+    manager->gc_step_vtree = vtree;
+    if(vtree==NULL) { //sweep completed
+      assert(!FULL_DEBUG || verify_counts_and_sizes(manager));
+      return 1;
+    }
+    manager->gc_step_node = INTERNAL(vtree)? vtree->nodes: NULL;
+  }
+  
+  return 0;
+}
+
 /****************************************************************************************
  * end
  ****************************************************************************************/
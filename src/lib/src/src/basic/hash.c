@@ -6,6 +6,10 @@
 
 #include "sdd.h"
 
+//basic/tables.c
+void* new_table(SddSize count, size_t size, SddManager* manager);
+void free_table(void* table, SddSize count, size_t size);
+
 /********************************************************************************************
  * allowed sized of hash tables
  *******************************************************************************************/
@@ -54,7 +58,7 @@ SddHash* new_unique_node_hash(SddManager* manager) {
   MALLOC(hash,SddHash,"NEW_HASH");
   //allocate array of collision lists
   //array must be initialized to null pointers: empty collision lists
-  CALLOC(hash->clists,SddNode*,size,"NEW_HASH");
+  hash->clists = new_table(size,sizeof(SddNode*),manager);
   
   hash->size  = size;
   hash->qsize = INITIAL_SIZE_UNIQUE_NODE_TABLE;
@@ -74,7 +78,7 @@ SddHash* new_unique_node_hash(SddManager* manager) {
  *******************************************************************************************/
 
 void free_hash(SddHash* hash) {
-  free(hash->clists);
+  free_table(hash->clists,hash->size,sizeof(SddNode*));
   free(hash);
 }
 
@@ -146,7 +150,7 @@ void try_resizing_hash(SddHash* hash, SddManager* manager) {
   
   //new array of collision lists
   hash->size = hash_qsizes[hash->qsize];
-  CALLOC(hash->clists,SddNode*,hash->size,"resize_sdd_node_hash");
+  hash->clists = new_table(hash->size,sizeof(SddNode*),manager);
   
   //insert nodes into new array of collision lists (using new hash keys)
   for(SddNode** old_clist=old_clists; old_clist<old_clists+old_size; ++old_clist) {
@@ -159,10 +163,21 @@ void try_resizing_hash(SddHash* hash, SddManager* manager) {
     });
   }
   
-  free(old_clists); //free old table
+  free_table(old_clists,old_size,sizeof(SddNode*)); //free old table
   hash->resize_age = 0; //reset resize age
 }
 
+//moves collision lists into a new array of the same size (see basic/tables.c)
+void relocate_hash_clists(SddHash* hash, SddManager* manager) {
+  SddNode** old_clists = hash->clists;
+  hash->clists = new_table(hash->size,sizeof(SddNode*),manager);
+  for(SddSize i=0; i<hash->size; i++) {
+    SddNode* first = hash->clists[i] = old_clists[i];
+    if(first) first->prev = hash->clists+i;
+  }
+  free_table(old_clists,hash->size,sizeof(SddNode*));
+}
+
 /********************************************************************************************
  * looking up entries in hash tables
  *******************************************************************************************/
@@ -9,6 +9,11 @@
 //basic/nodes.c
 void declare_lost_parent(SddNode* node, SddManager* manager);
 
+//basic/tables.c
+void* new_table(SddSize count, size_t size, SddManager* manager);
+void free_table(void* table, SddSize count, size_t size);
+void* new_spill_arena(SddManager* manager);
+
 /*****************************************************************************************
  * the following are critical assumptions about ids of nodes:
  *
@@ -34,8 +39,8 @@ void declare_lost_parent(SddNode* node, SddManager* manager);
 
 /****************************************************************************************
  * allocating nodes
- * first, allocation is attempted from gc lists
- * otherwise, malloc is called
+ * first, allocation is attempted from gc lists (from the spill arena for spilled vtrees)
+ * otherwise, decomposition nodes are carved from a slab and terminal nodes are malloc'd
  *
  * elements are different though: rotation and swap replace the elements of a node,
  * so they create and free elements which are not accounted for by manager->sdd_size
@@ -43,6 +48,145 @@ void declare_lost_parent(SddNode* node, SddManager* manager);
  * maximum number of elements existing in memory.
  ****************************************************************************************/
 
+/****************************************************************************************
+ * compact storage
+ *
+ * sdd_manager_compact() relocates the nodes of the unique table into one array of nodes
+ * (manager->compact_nodes) and one array of elements (manager->compact_elements)
+ *
+ * structures carved from these arrays (or from the spill arena, see below) are never
+ * passed to free(): nodes are recycled through the gc lists, and element arrays that are
+ * freed are kept in the lists of manager->compact_free_elements, by size (larger arrays
+ * in list 0), to be handed out again by new_elements(); the arrays are freed by the next
+ * compaction or by sdd_manager_free()
+ ****************************************************************************************/
+
+int in_compact_nodes(SddNode* node, SddManager* manager) {
+  return manager->compact_nodes!=NULL && 
+         node >= manager->compact_nodes &&
+         node <  manager->compact_nodes+manager->compact_node_count;
+}
+
+int in_compact_elements(SddElement* elements, SddManager* manager) {
+  return manager->compact_elements!=NULL && 
+         elements >= manager->compact_elements &&
+         elements <  manager->compact_elements+manager->compact_element_count;
+}
+
+//an element array on a free list (overlays its first element)
+typedef struct compact_free_t {
+  struct compact_free_t* next;
+  SddSize size;
+} CompactFree;
+
+static
+void push_compact_elements(SddSize size, SddElement* elements, SddManager* manager) {
+  assert(sizeof(CompactFree)<=sizeof(SddElement));
+  int list = size < COMPACT_FREE_LISTS? size: 0;
+  CompactFree* free_array = (CompactFree*)elements;
+  free_array->next = (CompactFree*)manager->compact_free_elements[list];
+  free_array->size = size;
+  manager->compact_free_elements[list] = (SddElement*)free_array;
+}
+
+//returns NULL if no freed array has size elements or more (only the first few arrays of
+//list 0 are examined); the unused tail of a larger array is put back on the lists
+static
+SddElement* pop_compact_elements(SddSize size, SddManager* manager) {
+  CompactFree** loc = NULL;
+  if(size < COMPACT_FREE_LISTS && manager->compact_free_elements[size]) {
+    loc = (CompactFree**)&(manager->compact_free_elements[size]);
+  }
+  else {
+    CompactFree** l = (CompactFree**)&(manager->compact_free_elements[0]);
+    for(int i=0; *l && i<COMPACT_FREE_SCAN; i++, l=&((*l)->next)) {
+      if((*l)->size >= size) { loc = l; break; }
+    }
+  }
+  if(loc==NULL) return NULL;
+  CompactFree* free_array = *loc;
+  *loc = free_array->next;
+  SddElement* elements = (SddElement*)free_array;
+  if(free_array->size > size) push_compact_elements(free_array->size-size,elements+size,manager);
+  memset(elements,0,size*sizeof(SddElement));
+  return elements;
+}
+
+/****************************************************************************************
+ * spill arena
+ *
+ * sdd_vtree_spill() marks the vtree nodes it pages out (vtree->spilled). the node
+ * structures and element arrays of new nodes normalized for marked vtrees are carved
+ * from manager->spill_arena, so that spilling the vtree again pages them out too
+ *
+ * the arena is one sparse spill table, created on first use if a spill directory is set,
+ * and handed out in order. it is managed like compact storage, and freed with it by the
+ * next compaction (which moves its nodes into the new compaction arrays). allocations
+ * fall back to memory when there is no arena or it is full
+ ****************************************************************************************/
+
+int in_spill_arena(void* p, SddManager* manager) {
+  return manager->spill_arena!=NULL &&
+         (char*) p >= manager->spill_arena &&
+         (char*) p <  manager->spill_arena+manager->spill_arena_used;
+}
+
+//returns zero-filled bytes of the arena, or NULL
+static
+void* new_arena_bytes(size_t bytes, SddManager* manager) {
+  if(manager->spill_arena==NULL) {
+    if(manager->spill_directory==NULL) return NULL;
+    manager->spill_arena      = new_spill_arena(manager);
+    manager->spill_arena_used = 0;
+    if(manager->spill_arena==NULL) return NULL;
+  }
+  bytes = (bytes+7)/8*8; //keeps pointers aligned
+  if(manager->spill_arena_used+bytes > SPILL_ARENA_SIZE) return NULL; //full
+  void* p = manager->spill_arena+manager->spill_arena_used;
+  manager->spill_arena_used += bytes;
+  return p;
+}
+
+/****************************************************************************************
+ * node slabs
+ *
+ * node structures of decomposition nodes are carved from slabs allocated by new_table,
+ * so large slabs get the huge page and numa placement of the manager (basic/tables.c).
+ * slabs double in size from NODE_SLAB_MIN_COUNT to NODE_SLAB_MAX_COUNT node structures
+ *
+ * as with compact storage, node structures carved from slabs are never passed to free():
+ * they are recycled through the gc lists. slabs are freed by sdd_manager_compact(),
+ * which frees every original node structure, and by sdd_manager_free()
+ ****************************************************************************************/
+
+static
+SddNode* new_slab_node(SddManager* manager) {
+  NodeSlab* slab = manager->node_slabs;
+  if(slab==NULL || manager->node_slab_used==slab->count) {
+    SddSize count = slab==NULL? NODE_SLAB_MIN_COUNT: MIN(2*slab->count,NODE_SLAB_MAX_COUNT);
+    MALLOC(slab,NodeSlab,"new_slab_node");
+    slab->nodes = new_table(count,sizeof(SddNode),manager);
+    slab->count = count;
+    slab->next  = manager->node_slabs;
+    manager->node_slabs     = slab;
+    manager->node_slab_used = 0;
+  }
+  return slab->nodes+(manager->node_slab_used++);
+}
+
+//the node structures of slabs must be freed first
+void free_node_slabs(SddManager* manager) {
+  NodeSlab* slab = manager->node_slabs;
+  while(slab) {
+    NodeSlab* next = slab->next;
+    free_table(slab->nodes,slab->count,sizeof(SddNode));
+    free(slab);
+    slab = next;
+  }
+  manager->node_slabs     = NULL;
+  manager->node_slab_used = 0;
+}
+
 /****************************************************************************************
  * allocating and freeing sdd elements
  ****************************************************************************************/
@@ -50,17 +194,34 @@ void declare_lost_parent(SddNode* node, SddManager* manager);
 //allocate an array to hold elements
 SddElement* new_elements(SddNodeSize size, SddManager* manager) {
   assert(size>0);
-  SddElement* elements;
-  CALLOC(elements,SddElement,size,"new_element_array");
+  SddElement* elements = pop_compact_elements(size,manager);
+  if(elements==NULL) CALLOC(elements,SddElement,size,"new_element_array");
   manager->stats.element_count += size; //number of elements currently in memory
   manager->stats.max_element_count = MAX(manager->stats.max_element_count,manager->stats.element_count);
   return elements;
 }
 
+//allocate an array to hold the elements of a node normalized for vtree
+SddElement* new_vtree_elements(SddNodeSize size, Vtree* vtree, SddManager* manager) {
+  assert(size>0);
+  if(vtree->spilled) {
+    SddElement* elements = new_arena_bytes(size*sizeof(SddElement),manager);
+    if(elements) {
+      manager->stats.element_count += size;
+      manager->stats.max_element_count = MAX(manager->stats.max_element_count,manager->stats.element_count);
+      return elements;
+    }
+  }
+  return new_elements(size,manager);
+}
+
 void free_elements(SddNodeSize size, SddElement* elements, SddManager* manager) {
   assert(size>0 || elements==NULL);
   assert(manager->stats.element_count >= size);
-  free(elements);
+  if(in_compact_elements(elements,manager) || in_spill_arena(elements,manager)) {
+    if(size) push_compact_elements(size,elements,manager);
+  }
+  else free(elements);
   manager->stats.element_count -= size; //number of elements currently in memory
   assert(manager->stats.max_element_count >= manager->stats.element_count);
 }
@@ -81,6 +242,10 @@ SddNode* new_sdd_node(SddNodeType type, SddNodeSize size, Vtree* vtree, SddManag
   if(type!=DECOMPOSITION) { //allocate terminal node
     MALLOC(node,SddNode,"new_sdd_node");
   }
+  else if(vtree->spilled && (node = new_arena_bytes(sizeof(SddNode),manager))) {
+    //new nodes of spilled vtrees bypass the gc lists, which hold structures in memory
+    ELEMENTS_OF(node) = new_vtree_elements(size,vtree,manager);
+  }
   else { //allocate decomposition 
     assert(size > 0);
     //allocate decomposition node
@@ -95,7 +260,7 @@ SddNode* new_sdd_node(SddNodeType type, SddNodeSize size, Vtree* vtree, SddManag
       //were of varying size when they were put there, their elements were freed)
     }
     else { //allocating new memory
-      MALLOC(node,SddNode,"new_sdd_node");
+      node = new_slab_node(manager);
       ELEMENTS_OF(node) = new_elements(size,manager);
     }
   }
@@ -109,8 +274,6 @@ SddNode* new_sdd_node(SddNodeType type, SddNodeSize size, Vtree* vtree, SddManag
   node->multiply_sub   = NULL;
   node->map            = NULL;
   node->shadow         = NULL;
-  node->saved_elements = NULL;
-  node->saved_size      = 0;
   node->ref_count       = 0; //nodes are born dead
   node->parent_count    = 0;
   node->index           = 0;
@@ -118,6 +281,8 @@ SddNode* new_sdd_node(SddNodeType type, SddNodeSize size, Vtree* vtree, SddManag
   node->cit             = 0;
   node->dit             = 0;
   node->git             = 0;
+  node->rit             = 0;
+  node->qit             = 0;
   node->in_unique_table = 0;
   node->replaced        = 0;
   node->user_bit        = 0;
@@ -148,6 +313,7 @@ void gc_sdd_node(SddNode* node, SddManager* manager) {
   
   if(IS_DECOMPOSITION(node)) {
     assert(node->ref_count==0); //must be dead
+    assert(node->rit==0 && node->qit==0); //no pending reference changes
     assert(node->in_unique_table==0); //cannot be in unique table
     declare_lost_parent(node,manager); //before gc which may free elements
   }
@@ -9,6 +9,7 @@
 //basic/memory.c
 SddNode* new_sdd_node(SddNodeType type, SddNodeSize size, Vtree* vtree, SddManager* manager);
 void free_elements(SddNodeSize size, SddElement* elements, SddManager* manager);
+int in_compact_nodes(SddNode* node, SddManager* manager);
 
 //basic/hash.c
 void insert_sdd_node(SddNode* node, SddHash* hash, SddManager* manager);
@@ -18,10 +19,11 @@ void remove_sdd_node(SddNode* node, SddHash* hash, SddManager* manager);
  * freeing an sdd node structure
  ****************************************************************************************/
  
+//node structures of decomposition nodes are freed with their slab or compaction array
+//(see basic/memory.c)
 void free_sdd_node(SddNode* node, SddManager* manager) {
   if(node->type==DECOMPOSITION) {
     free_elements(node->size,ELEMENTS_OF(node),manager);
-    free(node);
   }
   else free(node); //terminal sdd node
 }
@@ -50,7 +52,8 @@ void update_counts_and_sizes_after_unique_table_change(SddNode* node, SddManager
   
   //dead counts and sizes
   //live sizes are not maintained: computed from total/dead
-  if(node->ref_count==0) { //dead node
+  //dead counts follow node->rit, which may lag ref_count in deferred mode (see references.c)
+  if(node->rit==0) { //dead node
     manager->dead_node_count += inc;
     manager->dead_sdd_size   += inc*size;
     vtree->dead_node_count   += inc;
@@ -106,6 +109,8 @@ void remove_from_unique_table(SddNode* node, SddManager* manager) {
   assert(node->type==DECOMPOSITION);
   assert(node->in_unique_table==1);
   
+  //an incremental gc sweep must not resume at a node outside the unique table
+  if(manager->gc_step_node==node) manager->gc_step_node = node->vtree_next;
   //remove from hash table
   remove_sdd_node(node,manager->unique_nodes,manager);
   //remove from nodes of vtree
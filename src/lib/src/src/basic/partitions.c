@@ -10,7 +10,7 @@
 SddNode* lookup_sdd_node(SddElement* elements, SddNodeSize size, SddHash* hash, SddManager* manager);
 
 //basic/memory.c
-SddElement* new_elements(SddNodeSize size, SddManager* manager);
+SddElement* new_vtree_elements(SddNodeSize size, Vtree* vtree, SddManager* manager);
 
 //basic/nodes.c
 SddNode* construct_decomposition_sdd_node(SddNodeSize size, SddElement* elements, Vtree* vtree, SddManager* manager);
@@ -295,7 +295,7 @@ int GET_elements_of_partition(SddNodeSize* size, SddElement** elements, Vtree* v
   assert(success==0 || trim==NULL);
   
   if(success) {
-    *elements = new_elements(*size,manager);
+    *elements = new_vtree_elements(*size,vtree,manager);
     memcpy(*elements,buffer,*size*sizeof(SddElement));
     
     assert(elements_sorted_and_compressed(*size,*elements));
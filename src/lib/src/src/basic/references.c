@@ -6,22 +6,42 @@
 
 #include "sdd.h"
 
+/****************************************************************************************
+ * reference counts
+ *
+ * the ref_count of a decomposition node n is the number of external references to n,
+ * plus the number of elements (p,s) of live parents of n with p=n or s=n
+ *
+ * when a node becomes live (dead), its primes and subs gain (lose) a reference: this is
+ * propagated using an explicit worklist (ref_stack) instead of recursion, so releasing
+ * a large sdd does not consume the C stack
+ *
+ * the bit node->rit records whether the references of node to its primes and subs are
+ * currently accounted for (i.e., whether node is live as far as counts are concerned)
+ *
+ * deferred mode: sdd_ref/sdd_deref only update the ref_count of their argument; nodes
+ * that flip between live and dead are queued on deferred_ref_stack (marked by ->qit) and
+ * propagated in one sweep by sdd_manager_flush_deferred_refs(). a ref/deref pair on a
+ * temporary node then costs O(1). counts, sizes and ref_counts of descendants are exact
+ * only after flushing, which is done before gc, vtree operations and vtree search
+ ****************************************************************************************/
+
 /****************************************************************************************
  * updating counts and sizes
  ****************************************************************************************/
-  
+
+//node->rit has just been flipped
 static inline
 void update_counts_and_sizes_after_livelihood_change(SddNode* node, SddManager* manager) {
-  assert(node->ref_count==0 || node->ref_count==1);
   assert(node->type==DECOMPOSITION);
   if(node->in_unique_table==0) return;
-  
+
   Vtree* vtree = node->vtree;
   SddSize size = node->size;
-  int inc      = node->ref_count==1? -1: 1;
+  int inc      = node->rit? -1: 1;
   //live->dead: inc= +1
   //dead->live: inc= -1
-  
+
   //only dead counts and sizes need to be updated
   manager->dead_node_count += inc;
   manager->dead_sdd_size   += inc*size;
@@ -29,6 +49,54 @@ void update_counts_and_sizes_after_livelihood_change(SddNode* node, SddManager*
   vtree->dead_sdd_size     += inc*size;
 }
 
+/****************************************************************************************
+ * propagating livelihood changes
+ ****************************************************************************************/
+
+//nodes on ref_stack may have changed livelihood
+//a node on the stack whose ref_count agrees with its rit bit is skipped, so a node may
+//be pushed more than once
+static
+void propagate_livelihood_changes(SddManager* manager) {
+  while(!IS_STACK_EMPTY(ref_stack,manager)) {
+    SddNode* node = POP_STACK(ref_stack,manager);
+    assert(IS_DECOMPOSITION(node));
+    int live = node->ref_count > 0;
+    if(live==node->rit) continue; //references already accounted for
+    node->rit = live;
+    update_counts_and_sizes_after_livelihood_change(node,manager);
+    if(live) {
+      FOR_each_prime_sub_of_node(prime,sub,node,{
+        if(IS_DECOMPOSITION(prime) && ++prime->ref_count==1) PUSH_STACK(prime,SddNode*,ref_stack,manager);
+        if(IS_DECOMPOSITION(sub)   && ++sub->ref_count==1)   PUSH_STACK(sub,SddNode*,ref_stack,manager);
+      });
+    }
+    else {
+      FOR_each_prime_sub_of_node(prime,sub,node,{
+        assert(!IS_DECOMPOSITION(prime) || prime->ref_count);
+        assert(!IS_DECOMPOSITION(sub) || sub->ref_count);
+        if(IS_DECOMPOSITION(prime) && --prime->ref_count==0) PUSH_STACK(prime,SddNode*,ref_stack,manager);
+        if(IS_DECOMPOSITION(sub)   && --sub->ref_count==0)   PUSH_STACK(sub,SddNode*,ref_stack,manager);
+      });
+    }
+  }
+}
+
+//node has flipped between live and dead
+static inline
+void declare_livelihood_change(SddNode* node, SddManager* manager) {
+  if(manager->deferred_refs_on) { //queue node
+    if(node->qit==0) {
+      node->qit = 1;
+      PUSH_STACK(node,SddNode*,deferred_ref_stack,manager);
+    }
+  }
+  else { //propagate now
+    PUSH_STACK(node,SddNode*,ref_stack,manager);
+    propagate_livelihood_changes(manager);
+  }
+}
+
 /****************************************************************************************
  * high level
  ****************************************************************************************/
@@ -39,22 +107,18 @@ SddRefCount sdd_ref_count(SddNode* node) {
   if(IS_DECOMPOSITION(node)) return node->ref_count;
   else {
     assert(node->ref_count==0);
-    return 0; 
+    return 0;
   }
 }
 
 //returns node
 SddNode* sdd_ref(SddNode* node, SddManager* manager) {
   CHECK_ERROR(GC_NODE(node),ERR_MSG_GC,"sdd_ref");
-  
+
   if(IS_DECOMPOSITION(node) && ++node->ref_count==1) { //node was dead and became live
-    update_counts_and_sizes_after_livelihood_change(node,manager);
-    FOR_each_prime_sub_of_node(prime,sub,node,{
-      sdd_ref(prime,manager);
-      sdd_ref(sub,manager);
-    });
+    declare_livelihood_change(node,manager);
   }
-  
+
   return node;
 }
 
@@ -64,16 +128,42 @@ SddNode* sdd_deref(SddNode* node, SddManager* manager) {
   CHECK_ERROR(IS_DECOMPOSITION(node) && node->ref_count==0,ERR_MSG_DEREF,"sdd_deref");
 
   if(IS_DECOMPOSITION(node) && --node->ref_count==0) { //node was live and became dead
-    update_counts_and_sizes_after_livelihood_change(node,manager);
-    FOR_each_prime_sub_of_node(prime,sub,node,{
-      sdd_deref(prime,manager);
-      sdd_deref(sub,manager);
-    });
+    declare_livelihood_change(node,manager);
   }
- 
+
   return node;
 }
 
+/****************************************************************************************
+ * deferred mode
+ ****************************************************************************************/
+
+//propagates all queued livelihood changes
+//counts, sizes and reference counts are exact afterwards
+void sdd_manager_flush_deferred_refs(SddManager* manager) {
+  while(!IS_STACK_EMPTY(deferred_ref_stack,manager)) {
+    SddNode* node = POP_STACK(deferred_ref_stack,manager);
+    assert(node->qit && !GC_NODE(node));
+    node->qit = 0;
+    PUSH_STACK(node,SddNode*,ref_stack,manager);
+    propagate_livelihood_changes(manager);
+  }
+}
+
+void sdd_manager_deferred_refs_on(SddManager* manager) {
+  manager->deferred_refs_on = 1;
+}
+
+//queued changes are propagated before leaving deferred mode
+void sdd_manager_deferred_refs_off(SddManager* manager) {
+  sdd_manager_flush_deferred_refs(manager);
+  manager->deferred_refs_on = 0;
+}
+
+int sdd_manager_is_deferred_refs_on(SddManager* manager) {
+  return manager->deferred_refs_on;
+}
+
 /****************************************************************************************
  * end
  ****************************************************************************************/
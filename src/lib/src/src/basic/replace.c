@@ -19,8 +19,16 @@ void declare_lost_parent(SddNode* node, SddManager* manager);
  * does not deal with the insertion/deletion of the node into a unique table
  ****************************************************************************************/
 
+/****************************************************************************************
+ * reversible replacements are recorded on the replacement journal of the manager: an
+ * append-only stack of (node, elements, size) entries holding the replaced elements
+ *
+ * a vtree operation either commits all its replacements (freeing replaced elements and
+ * emptying the journal) or rolls them all back (in reverse order)
+ ****************************************************************************************/
+
 //assumes node is live
-//if replacement is reversible, then save current elements (instead of freeing them)
+//if replacement is reversible, then journal current elements (instead of freeing them)
 //if replacement is irreversible, then free current elements
 void replace_node(int reversible, SddNode* node, SddNodeSize new_size, SddElement* new_elements, Vtree* new_vtree, SddManager* manager) {
   assert(node->ref_count); //live
@@ -46,44 +54,42 @@ void replace_node(int reversible, SddNode* node, SddNodeSize new_size, SddElemen
   while(ref_count--) sdd_ref(node,manager); //re-establish references
   //node is now live again
    
-  //save or free current elements
+  //journal or free current elements
   if(reversible) {
-    node->replaced       = 1; //replacement reversible
-    node->saved_size     = cur_size;
-    node->saved_elements = cur_elements;
+    assert(node->replaced==0); //a node is replaced at most once per vtree operation
+    node->replaced = 1; //replacement reversible
+    RESIZE_STACK_IF_FULL(SddReplacement,replacement_journal,manager);
+    SddReplacement* r = manager->top_replacement_journal++;
+    r->node     = node;
+    r->elements = cur_elements;
+    r->size     = cur_size;
   }
   else {
-    node->replaced       = 0; //replacement is irreversible
-    node->saved_size     = 0;
-    node->saved_elements = NULL;
+    node->replaced = 0; //replacement is irreversible
     free_elements(cur_size,cur_elements,manager);
   }
 }
 
-//confirms a reversible replacement: free saved elements and insert in unique table
-//once replacement is confirmed, it cannot be reversed
-void confirm_node_replacement(SddNode* node, SddManager* manager) {
-  assert(node->replaced); //was replaced
-  assert(node->saved_elements); //has saved elements
-  assert(node->ref_count); //live
-  assert(node->type==DECOMPOSITION); //not terminal
-
-  node->replaced = 0; //no longer reversible
-  free_elements(node->saved_size,node->saved_elements,manager);
-
-  node->saved_size     = 0;
-  node->saved_elements = NULL;
+//confirms all journaled replacements: frees replaced elements and empties the journal
+//once replacements are confirmed, they cannot be reversed
+void commit_node_replacements(SddManager* manager) {
+  for(SddReplacement* r=manager->start_replacement_journal; r<manager->top_replacement_journal; r++) {
+    assert(r->node->replaced);
+    r->node->replaced = 0; //no longer reversible
+    free_elements(r->size,r->elements,manager);
+  }
+  RESET_STACK(replacement_journal,manager);
 }
 
-//reverse a replacement: recover saved elements and insert in unique table
-void reverse_node_replacement(SddNode* node, Vtree* vtree, SddManager* manager) {
-  assert(node->replaced); //was replaced
-  assert(node->saved_elements); //has saved elements
-  assert(node->ref_count); //live
-  assert(node->type==DECOMPOSITION); //not terminal
- 
-  int reversible = 0; //replacement is not reversible (current elements will be freed)
-  replace_node(reversible,node,node->saved_size,node->saved_elements,vtree,manager);
+//reverses all journaled replacements (latest first), normalizing nodes for vtree
+void rollback_node_replacements(Vtree* vtree, SddManager* manager) {
+  int reversible = 0; //reversal is not reversible (current elements will be freed)
+  while(!IS_STACK_EMPTY(replacement_journal,manager)) {
+    SddReplacement* r = --manager->top_replacement_journal;
+    assert(r->node->replaced);
+    assert(r->node->ref_count); //live
+    replace_node(reversible,r->node,r->size,r->elements,vtree,manager); //clears replaced
+  }
 }
 
 /*****************************************************************************************
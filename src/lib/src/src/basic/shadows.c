@@ -7,7 +7,7 @@
 #include "sdd.h"
 
 //basic/memory.c
-SddElement* new_elements(SddNodeSize size, SddManager* manager);
+SddElement* new_vtree_elements(SddNodeSize size, Vtree* vtree, SddManager* manager);
 
 //basic/nodes.c
 void remove_from_unique_table(SddNode* node, SddManager* manager);
@@ -114,6 +114,85 @@ int shadow_is_internal(NodeShadow* shadow) {
   return shadow->size>0;
 }
 
+/****************************************************************************************
+ * shadow arena
+ *
+ * the shadows of a shadow-DAG, and their element arrays, are carved from chunks owned by
+ * the SddShadows structure; freeing a shadow only updates counts, and all chunks are
+ * released at once when the shadow-DAG is freed or recovered
+ *
+ * released chunks of standard size are pooled by the manager, so repeatedly building and
+ * releasing shadow-DAGs (fragments, sdd_exists_multiple) does not call malloc
+ ****************************************************************************************/
+
+#define ARENA_ALIGN(B) ((((B)+sizeof(void*)-1)/sizeof(void*))*sizeof(void*))
+
+static
+ShadowChunk* new_shadow_chunk(size_t size, SddManager* manager) {
+  ShadowChunk* chunk;
+  if(size==SHADOW_CHUNK_SIZE && manager->shadow_chunks) { //reuse pooled chunk
+    chunk = manager->shadow_chunks;
+    manager->shadow_chunks = chunk->next;
+    --manager->shadow_chunk_count;
+  }
+  else {
+    chunk = (ShadowChunk*) malloc(sizeof(ShadowChunk)+size);
+    CHECK_ERROR(chunk==NULL,"\nerror in %s: malloc failed\n","new_shadow_chunk");
+    chunk->size = size;
+  }
+  chunk->used = 0;
+  return chunk;
+}
+
+static
+void* arena_alloc(size_t bytes, SddShadows* shadows) {
+  bytes = ARENA_ALIGN(bytes);
+  ShadowChunk* chunk = shadows->chunks;
+  if(chunk==NULL || chunk->used+bytes > chunk->size) {
+    chunk = new_shadow_chunk(MAX(bytes,SHADOW_CHUNK_SIZE),shadows->manager);
+    if(shadows->chunks && bytes>SHADOW_CHUNK_SIZE) { //keep current chunk first
+      chunk->next = shadows->chunks->next;
+      shadows->chunks->next = chunk;
+    }
+    else {
+      chunk->next = shadows->chunks;
+      shadows->chunks = chunk;
+    }
+  }
+  void* memory = ((char*) (chunk+1)) + chunk->used;
+  chunk->used += bytes;
+  return memory;
+}
+
+//releases all chunks of the arena (standard chunks are pooled by the manager)
+static
+void arena_free(SddShadows* shadows) {
+  SddManager* manager = shadows->manager;
+  ShadowChunk* chunk  = shadows->chunks;
+  while(chunk) {
+    ShadowChunk* next = chunk->next;
+    if(chunk->size==SHADOW_CHUNK_SIZE && manager->shadow_chunk_count < MAX_SHADOW_CHUNK_POOL) {
+      chunk->next = manager->shadow_chunks;
+      manager->shadow_chunks = chunk;
+      ++manager->shadow_chunk_count;
+    }
+    else free(chunk);
+    chunk = next;
+  }
+  shadows->chunks = NULL;
+}
+
+void free_shadow_chunks(SddManager* manager) {
+  ShadowChunk* chunk = manager->shadow_chunks;
+  while(chunk) {
+    ShadowChunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  manager->shadow_chunks      = NULL;
+  manager->shadow_chunk_count = 0;
+}
+
 /****************************************************************************************
  * allocating and freeing shadows and specs
  ****************************************************************************************/
@@ -125,8 +204,7 @@ NodeShadow* leaf_shadow_new(SddNode* node, SddShadows* shadows) {
   ++shadows->shadow_count;
   shadows->shadow_byte_count += sizeof(NodeShadow);
   
-  NodeShadow* shadow;
-  MALLOC(shadow,NodeShadow,"leaf_shadow_new");
+  NodeShadow* shadow = arena_alloc(sizeof(NodeShadow),shadows);
   
   sdd_ref(node,shadows->manager);  //protect
   
@@ -146,10 +224,9 @@ NodeShadow* internal_shadow_new(SddNode* node, SddShadows* shadows) {
   ++shadows->shadow_count;
   shadows->shadow_byte_count += sizeof(NodeShadow) + node->size*sizeof(ElmShadow);
   
-  NodeShadow* shadow;
-  MALLOC(shadow,NodeShadow,"internal_shadow_new");
+  NodeShadow* shadow = arena_alloc(sizeof(NodeShadow),shadows);
   
-  CALLOC(ELMS_OF(shadow),ElmShadow,node->size,"internal_shadow_new");
+  ELMS_OF(shadow) = arena_alloc(node->size*sizeof(ElmShadow),shadows); //filled by caller
   shadow->vtree        = node->vtree;
   shadow->size         = node->size;
   shadow->ref_count    = 1;
@@ -168,8 +245,7 @@ void leaf_shadow_free(NodeShadow* shadow, SddShadows* shadows) {
   
   SddNode* node = NODE_OF(shadow);
   if(node) sdd_deref(node,shadows->manager); //release
-  
-  free(shadow);
+  //memory of shadow is released with the arena
 }
 
 /****************************************************************************************
@@ -183,7 +259,7 @@ void convert_internal_shadow_to_leaf(SddNode* node, NodeShadow* shadow, SddShado
   
   if(node) sdd_ref(node,shadows->manager); //protect
   
-  free(ELMS_OF(shadow)); //before setting node
+  //memory of elements is released with the arena
   NODE_OF(shadow)  = node; //may be NULL (when freeing shadows)
   shadow->vtree    = node? node->vtree: NULL;
   shadow->size     = 0;
@@ -201,6 +277,7 @@ NodeShadow* shadow_from_node(SddNode* node, SddShadows* shadows) {
   assert(node->shadow_type=='t' || node->shadow_type=='g' || node->shadow_type=='c');
   
   if(node->shadow) { //already constructed
+    CHECK_ERROR(node->shadow->ref_count==MAX_SHADOW_REF_COUNT,ERR_MSG_SHADOW_REFS,"shadow_from_node"); //30-bit counter
     ++node->shadow->ref_count; //additional reference
     return node->shadow; 
   }
@@ -253,7 +330,7 @@ SddNode* node_from_shadow(NodeShadow* shadow, SddShadows* shadows) {
     else { //internal shadow with reuse: replace elements/vtree of saved node structure
       node = shadow->cache;   
       assert(node->in_unique_table);
-      SddElement* elements  = new_elements(size,manager);
+      SddElement* elements  = new_vtree_elements(size,vtree,manager);
       for(SddNodeSize i=0; i<size; i++) {
         elements[i].prime = node_from_shadow(s_elements[i].prime,shadows);
         elements[i].sub   = node_from_shadow(s_elements[i].sub,shadows);
@@ -328,6 +405,7 @@ SddShadows* shadows_new(SddSize root_count, SddNode** root_nodes, SddManager* ma
   shadows->root_shadows      = NULL;
   shadows->shadow_count      = 0;
   shadows->shadow_byte_count = 0;
+  shadows->chunks            = NULL;
   shadows->bit               = 0;
   
   if(root_count==0) return shadows;
@@ -354,6 +432,7 @@ void shadows_recover(SddShadows* shadows) {
   assert(shadows->shadow_count==0); 
   assert(shadows->shadow_byte_count==0); 
   
+  arena_free(shadows);
   free(shadows->root_shadows);  
   free(shadows);
 }
@@ -375,6 +454,7 @@ void shadows_free(SddShadows* shadows) {
   assert(shadows->shadow_count==0); 
   assert(shadows->shadow_byte_count==0);
   
+  arena_free(shadows);
   free(shadows->root_shadows);
   free(shadows);
 }
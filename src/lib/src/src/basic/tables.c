@@ -0,0 +1,239 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+#include <stdint.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define SPILL_TABLES 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+//basic/hash.c
+void relocate_hash_clists(SddHash* hash, SddManager* manager);
+
+/****************************************************************************************
+ * large tables
+ *
+ * the collision lists of the unique table, the computed caches, the node slabs and the
+ * compaction arrays are large and accessed randomly, so they are prone to TLB misses
+ *
+ * on linux, a table that spans at least one huge page is mapped directly (rounded up to
+ * a multiple of HUGE_PAGE_SIZE, so it can be unmapped without knowing how it was mapped):
+ * --manager->huge_pages==0: regular pages
+ * --manager->huge_pages==1: transparent huge pages (madvise)
+ * --manager->huge_pages==2: explicit huge pages (MAP_HUGETLB), which need pages reserved
+ *   by the system; falls back to transparent huge pages otherwise
+ *
+ * if manager->numa_node is not negative, the pages of a mapped table are preferably
+ * allocated on that numa node (they are allocated on first touch)
+ *
+ * smaller tables, and all tables on other systems, are allocated by calloc
+ ****************************************************************************************/
+
+static inline
+size_t table_byte_count(SddSize count, size_t size) {
+  size_t bytes = count*size;
+#ifdef __linux__
+  if(bytes >= HUGE_PAGE_SIZE) bytes = ((bytes+HUGE_PAGE_SIZE-1)/HUGE_PAGE_SIZE)*HUGE_PAGE_SIZE;
+#endif
+  return bytes;
+}
+
+#ifdef __linux__
+static
+void* map_table(size_t bytes, SddManager* manager) {
+  void* table = MAP_FAILED;
+  int flags   = MAP_PRIVATE|MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+  if(manager->huge_pages==2) table = mmap(NULL,bytes,PROT_READ|PROT_WRITE,flags|MAP_HUGETLB,-1,0);
+#endif
+  if(table==MAP_FAILED) {
+    table = mmap(NULL,bytes,PROT_READ|PROT_WRITE,flags,-1,0);
+    CHECK_ERROR(table==MAP_FAILED,ERR_MSG_MMAP,"new_table");
+#ifdef MADV_HUGEPAGE
+    if(manager->huge_pages) madvise(table,bytes,MADV_HUGEPAGE); //advice only
+#endif
+  }
+#ifdef SYS_mbind
+  if(manager->numa_node >= 0) {
+    //MPOL_PREFERRED (1): failure leaves the default policy in place
+    //maxnode is one more than the number of bits in the mask (the kernel reads maxnode-1)
+    unsigned long mask = 1UL << manager->numa_node;
+    syscall(SYS_mbind,table,bytes,1,&mask,8*sizeof(mask)+1,0);
+  }
+#endif
+  return table; //anonymous mappings are zero-filled
+}
+#endif
+
+//returns a zero-filled array of count entries of the given size
+void* new_table(SddSize count, size_t size, SddManager* manager) {
+  if(count==0) return NULL;
+  size_t bytes = table_byte_count(count,size);
+#ifdef __linux__
+  if(bytes >= HUGE_PAGE_SIZE) return map_table(bytes,manager);
+#endif
+  void* table;
+  CALLOC(table,char,bytes,"new_table");
+  return table;
+}
+
+//count and size must be those passed to new_table
+void free_table(void* table, SddSize count, size_t size) {
+  if(table==NULL) return;
+  size_t bytes = table_byte_count(count,size);
+#ifdef __linux__
+  if(bytes >= HUGE_PAGE_SIZE) {
+    munmap(table,bytes);
+    return;
+  }
+#endif
+  free(table);
+}
+
+/****************************************************************************************
+ * spill tables
+ *
+ * when manager->spill_directory is set, the compaction arrays are mapped from an
+ * unlinked file in that directory (MAP_SHARED): under memory pressure, the kernel writes
+ * their cold pages to the file instead of failing, and reads them back on access
+ *
+ * nodes allocated after the compaction are file-backed only if their vtree was spilled:
+ * they are carved from the spill arena (see basic/memory.c), a sparse spill table
+ *
+ * the file is sized in multiples of HUGE_PAGE_SIZE so the mapping can be unmapped
+ * without further bookkeeping; on systems without mmap, regular tables are used
+ ****************************************************************************************/
+
+static inline
+size_t spill_table_byte_count(SddSize count, size_t size) {
+  return ((count*size+HUGE_PAGE_SIZE-1)/HUGE_PAGE_SIZE)*HUGE_PAGE_SIZE;
+}
+
+//returns a zero-filled array of count entries of the given size
+void* new_spill_table(SddSize count, size_t size, SddManager* manager) {
+  if(count==0) return NULL;
+#ifdef SPILL_TABLES
+  size_t bytes = spill_table_byte_count(count,size);
+  size_t length = strlen(manager->spill_directory);
+  char* path;
+  CALLOC(path,char,length+32,"new_spill_table");
+  sprintf(path,"%s/sdd-spill-XXXXXX",manager->spill_directory);
+  int fd = mkstemp(path);
+  CHECK_ERROR(fd<0,"\nerror in %s: cannot create spill file\n","new_spill_table");
+  unlink(path); //file is removed once unmapped
+  free(path);
+  CHECK_ERROR(ftruncate(fd,bytes),"\nerror in %s: cannot size spill file\n","new_spill_table");
+  void* table = mmap(NULL,bytes,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+  close(fd); //mapping keeps the file open
+  CHECK_ERROR(table==MAP_FAILED,"\nerror in %s: cannot map spill file\n","new_spill_table");
+  return table; //extended files read as zeros
+#else
+  return new_table(count,size,manager);
+#endif
+}
+
+//count and size must be those passed to new_spill_table
+void free_spill_table(void* table, SddSize count, size_t size) {
+  if(table==NULL) return;
+#ifdef SPILL_TABLES
+  munmap(table,spill_table_byte_count(count,size));
+#else
+  free_table(table,count,size);
+#endif
+}
+
+//returns a spill table of SPILL_ARENA_SIZE bytes (its file is sparse, so only the pages
+//used take space), or NULL on systems without mmap
+void* new_spill_arena(SddManager* manager) {
+#ifdef SPILL_TABLES
+  return new_spill_table(SPILL_ARENA_SIZE,1,manager);
+#else
+  return NULL;
+#endif
+}
+
+void free_spill_arena(void* arena) {
+  free_spill_table(arena,SPILL_ARENA_SIZE,1);
+}
+
+//advises the kernel that bytes [start,end) of a spill table will not be used soon:
+//whole pages inside the range are written back and dropped from memory
+void spill_range(void* start, void* end) {
+#ifdef SPILL_TABLES
+  size_t page = (size_t) sysconf(_SC_PAGESIZE);
+  uintptr_t first = (((uintptr_t) start)+page-1)/page*page;
+  uintptr_t last  = ((uintptr_t) end)/page*page;
+  if(first>=last) return;
+#if defined(MADV_PAGEOUT)
+  madvise((void*) first,last-first,MADV_PAGEOUT);
+#else
+  madvise((void*) first,last-first,MADV_DONTNEED); //shared file pages are preserved
+#endif
+#endif
+}
+
+//directory: where the spill files of the next compactions are created (NULL to stop
+//spilling at the next compaction); the arrays of earlier compactions are not moved
+void sdd_manager_set_spill_directory(const char* directory, SddManager* manager) {
+  free(manager->spill_directory);
+  manager->spill_directory = NULL;
+  if(directory) {
+    CALLOC(manager->spill_directory,char,strlen(directory)+1,"sdd_manager_set_spill_directory");
+    strcpy(manager->spill_directory,directory);
+  }
+}
+
+/****************************************************************************************
+ * placement options
+ ****************************************************************************************/
+
+//moves the computed caches and the unique table into tables allocated under the
+//current options (node slabs and compaction arrays follow the options when they are
+//next allocated)
+static
+void relocate_tables(SddManager* manager) {
+  SddComputed* conjoin_cache = new_table(COMPUTED_CACHE_SIZE,sizeof(SddComputed),manager);
+  SddComputed* disjoin_cache = new_table(COMPUTED_CACHE_SIZE,sizeof(SddComputed),manager);
+  memcpy(conjoin_cache,manager->conjoin_cache,COMPUTED_CACHE_SIZE*sizeof(SddComputed));
+  memcpy(disjoin_cache,manager->disjoin_cache,COMPUTED_CACHE_SIZE*sizeof(SddComputed));
+  free_table(manager->conjoin_cache,COMPUTED_CACHE_SIZE,sizeof(SddComputed));
+  free_table(manager->disjoin_cache,COMPUTED_CACHE_SIZE,sizeof(SddComputed));
+  manager->conjoin_cache = conjoin_cache;
+  manager->disjoin_cache = disjoin_cache;
+
+  //caches of other operations are allocated again when next used
+  free_table(manager->ite_cache,ITE_CACHE_SIZE,sizeof(SddIteComputed));
+  manager->ite_cache          = NULL;
+  manager->ite_computed_count = 0;
+  free_op_cache(&manager->and_exists_cache);
+  free_op_cache(&manager->restrict_cache);
+
+  relocate_hash_clists(manager->unique_nodes,manager);
+}
+
+//mode: 0 (regular pages), 1 (transparent huge pages), 2 (explicit huge pages)
+void sdd_manager_set_huge_pages(int mode, SddManager* manager) {
+  CHECK_ERROR(mode<0 || mode>2,"\nerror in %s: huge page mode must be 0, 1 or 2\n","sdd_manager_set_huge_pages");
+  manager->huge_pages = mode;
+  relocate_tables(manager);
+}
+
+//node: numa node on which tables are preferably placed (-1 for no preference)
+void sdd_manager_set_numa_node(int node, SddManager* manager) {
+  CHECK_ERROR(node<-1 || node>=(int)(8*sizeof(unsigned long)),"\nerror in %s: invalid numa node\n","sdd_manager_set_numa_node");
+  manager->numa_node = node;
+  relocate_tables(manager);
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
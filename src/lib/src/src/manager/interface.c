@@ -51,6 +51,12 @@ int sdd_manager_is_auto_gc_and_minimize_on(SddManager* manager) {
   return manager->auto_gc_and_search_on;
 }
 
+//a positive budget replaces the gc triggered after top-level applies by an incremental
+//gc step of that budget (see sdd_manager_gc_step); 0 restores the default behavior
+void sdd_manager_set_gc_step_budget(SddSize budget, SddManager* manager) {
+  manager->gc_step_budget = budget;
+}
+
 void sdd_manager_set_minimize_function(SddVtreeSearchFunc f, SddManager* manager) {
   manager->vtree_search_function = f;
 }
@@ -220,6 +226,16 @@ SddNode* sdd_disjoin(SddNode* node1, SddNode* node2, SddManager* manager) {
   return sdd_apply(node1,node2,DISJOIN,manager);
 }
 
+//equiv: ite(node1,node2,~node2)
+//xor  : ite(node1,~node2,node2)
+SddNode* sdd_xor(SddNode* node1, SddNode* node2, SddManager* manager) {
+  return sdd_ite(node1,sdd_negate(node2,manager),node2,manager);
+}
+
+SddNode* sdd_equiv(SddNode* node1, SddNode* node2, SddManager* manager) {
+  return sdd_ite(node1,node2,sdd_negate(node2,manager),manager);
+}
+
 /****************************************************************************************
  * garbage collection
  ****************************************************************************************/
@@ -232,6 +248,7 @@ void sdd_manager_garbage_collect(SddManager* manager) {
 //runs a global garbage collection when the number of dead nodes exceeds a certain threshold
 //this is more efficient than calling sdd_manager_garbage_collect_if on vtree of manager
 int sdd_manager_garbage_collect_if(float dead_node_threshold, SddManager* manager) {
+  sdd_manager_flush_deferred_refs(manager); //exact dead count
   SddSize dead_node_count  = sdd_manager_dead_count(manager); //more efficient
   SddSize total_node_count = sdd_manager_count(manager); //more efficient
   if(dead_node_count > total_node_count*dead_node_threshold) {
@@ -243,6 +260,7 @@ int sdd_manager_garbage_collect_if(float dead_node_threshold, SddManager* manage
 
 //runs a local garbage collection when the number of dead nodes exceeds a certain threshold
 int sdd_vtree_garbage_collect_if(float dead_node_threshold, Vtree* vtree, SddManager* manager) {
+  sdd_manager_flush_deferred_refs(manager); //exact dead count
   SddSize dead_node_count  = sdd_vtree_dead_count(vtree);
   SddSize total_node_count = sdd_vtree_count(vtree);
   if(dead_node_count > total_node_count*dead_node_threshold) {
@@ -295,6 +313,12 @@ void sdd_manager_set_vtree_cartesian_product_limit(SddSize size_limit, SddManage
   manager->vtree_ops.cartesian_product_limit = size_limit;
 }
 
+// this is used by exact_window_pass(), invoked at the end of vtree search (0 turns it off)
+void sdd_manager_set_vtree_search_exact_window(SddLiteral var_count, SddManager* manager) {
+  CHECK_ERROR(var_count<0 || var_count>EXACT_WINDOW_MAX_VAR_COUNT,"\nerror in %s: invalid window size\n","sdd_manager_set_vtree_search_exact_window");
+  manager->vtree_ops.exact_window_var_count = var_count;
+}
+
 /****************************************************************************************
  * manager options
  ****************************************************************************************/
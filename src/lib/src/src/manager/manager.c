@@ -12,6 +12,17 @@
 SddHash* new_unique_node_hash(SddManager* manager);
 void free_hash(SddHash* hash);
 
+//basic/compact.c
+void free_compact_arrays(SddManager* manager);
+void free_node_slabs(SddManager* manager);
+
+//basic/shadows.c
+void free_shadow_chunks(SddManager* manager);
+
+//basic/tables.c
+void* new_table(SddSize count, size_t size, SddManager* manager);
+void free_table(void* table, SddSize count, size_t size);
+
 //basic/nodes.c
 void free_sdd_node(SddNode* node, SddManager* manager);
 SddNode* construct_literal_sdd_node(SddLiteral literal, Vtree* vtree, SddManager* manager);
@@ -57,6 +68,7 @@ SddManager* sdd_manager_new(Vtree* input_vtree) {
   manager->node_count      = 0;
   manager->dead_node_count = 0;
   manager->computed_count  = 0;
+  manager->ite_computed_count = 0;
 
   //sizes
   manager->sdd_size      = 0;
@@ -68,14 +80,48 @@ SddManager* sdd_manager_new(Vtree* input_vtree) {
   
   CALLOC(manager->gc_node_lists,SddNode*,GC_BUCKETS_COUNT,"new_sdd_manager");
   
+  //placement of large tables (before allocating them)
+  manager->huge_pages = 0;
+  manager->numa_node  = -1;
+  manager->spill_directory = NULL;
+  
+  //node slabs
+  manager->node_slabs     = NULL;
+  manager->node_slab_used = 0;
+  
+  //compaction
+  manager->compact_nodes         = NULL;
+  manager->compact_node_count    = 0;
+  manager->compact_elements      = NULL;
+  manager->compact_element_count = 0;
+  manager->compact_spilled       = 0;
+  manager->node_registrations    = NULL;
+  manager->wmc_manager_count     = 0;
+  manager->pin_count             = 0;
+  for(int i=0; i<COMPACT_FREE_LISTS; i++) manager->compact_free_elements[i] = NULL;
+  manager->spill_arena           = NULL;
+  manager->spill_arena_used      = 0;
+  
+  //shadow arenas
+  manager->shadow_chunks      = NULL;
+  manager->shadow_chunk_count = 0;
+  
+  //incremental gc
+  manager->gc_step_budget = 0;
+  manager->gc_step_vtree  = NULL;
+  manager->gc_step_node   = NULL;
+  
   //unique nodes
   manager->unique_nodes = new_unique_node_hash(manager);
   
   //computation caches
   manager->computed_cache_lookup_count = 0;
   manager->computed_cache_hit_count    = 0;
-  CALLOC(manager->conjoin_cache,SddComputed,COMPUTED_CACHE_SIZE,"new_sdd_manager");
-  CALLOC(manager->disjoin_cache,SddComputed,COMPUTED_CACHE_SIZE,"new_sdd_manager");
+  manager->conjoin_cache = new_table(COMPUTED_CACHE_SIZE,sizeof(SddComputed),manager);
+  manager->disjoin_cache = new_table(COMPUTED_CACHE_SIZE,sizeof(SddComputed),manager);
+  manager->ite_cache     = NULL; //allocated on first use
+  init_op_cache(AND_EXISTS_CACHE_SIZE,&manager->and_exists_cache);
+  init_op_cache(RESTRICT_CACHE_SIZE,&manager->restrict_cache);
   
   //apply
   manager->apply_depth = 0;
@@ -89,6 +135,7 @@ SddManager* sdd_manager_new(Vtree* input_vtree) {
   
   //indexing leaf vtrees: NULL, 1, 2, ..., var_count
   CALLOC(manager->leaf_vtrees,Vtree *,1+var_count,"new_sdd_manager");
+  CALLOC(manager->var_holds,SddSize,1+var_count,"new_sdd_manager");
   
   //stacks
   CALLOC(manager->start_compression_stack,SddElement,INITIAL_SIZE_ELEMENT_STACK,"new_sdd_manager");
@@ -118,6 +165,19 @@ SddManager* sdd_manager_new(Vtree* input_vtree) {
   CALLOC(manager->node_buffer,SddNode*,INITIAL_SIZE_NODE_BUFFER,"new_sdd_manager");
   manager->node_buffer_size = INITIAL_SIZE_NODE_BUFFER;  
   
+  CALLOC(manager->start_ref_stack,SddNode*,INITIAL_SIZE_REF_STACK,"new_sdd_manager");
+  manager->top_ref_stack      = manager->start_ref_stack;
+  manager->capacity_ref_stack = INITIAL_SIZE_REF_STACK;
+  
+  CALLOC(manager->start_deferred_ref_stack,SddNode*,INITIAL_SIZE_REF_STACK,"new_sdd_manager");
+  manager->top_deferred_ref_stack      = manager->start_deferred_ref_stack;
+  manager->capacity_deferred_ref_stack = INITIAL_SIZE_REF_STACK;
+  manager->deferred_refs_on            = 0;
+  
+  CALLOC(manager->start_replacement_journal,SddReplacement,INITIAL_SIZE_REPLACEMENT_JOURNAL,"new_sdd_manager");
+  manager->top_replacement_journal      = manager->start_replacement_journal;
+  manager->capacity_replacement_journal = INITIAL_SIZE_REPLACEMENT_JOURNAL;
+  
   //manager options
   manager->options = NULL;
   
@@ -136,7 +196,8 @@ SddManager* sdd_manager_new(Vtree* input_vtree) {
                                   0,0,0,0,0,0,0,0,0,0,0,0,0,0,
                                   ' ',
                                   INITIAL_CONVERGENCE_THRESHOLD,
-                                  CARTESIAN_PRODUCT_LIMIT};
+                                  CARTESIAN_PRODUCT_LIMIT,
+                                  EXACT_WINDOW_VAR_COUNT};
   manager->vtree_ops = vtree_ops;
   
   //automatic garbage collection and search
@@ -158,6 +219,12 @@ SddManager* sdd_manager_new(Vtree* input_vtree) {
   manager->auto_search_iteration_count            = 0;
   manager->auto_gc_invocation_count               = 0;
   manager->auto_search_reduction_sum              = 0;
+  manager->auto_search_policy                     = 'f';
+  manager->auto_global_growth                     = 0;
+  manager->auto_local_growth                      = 0;
+  manager->auto_apply_growth                      = 0;
+  manager->auto_apply_time                        = 0;
+  manager->auto_search_time_mark                  = 0;
   manager->vtree_search_function                  = NULL;
   
   //vtree fragments
@@ -275,9 +342,23 @@ void sdd_manager_free(SddManager* manager) {
   }
   free(manager->gc_node_lists);
   
+  //node slabs and arrays of last compaction (after freeing the nodes they hold)
+  free_node_slabs(manager);
+  free_compact_arrays(manager);
+  free(manager->spill_directory);
+  
+  //node registrations of environments not freed before the manager
+  while(manager->node_registrations) unregister_nodes(manager->node_registrations->nodes,manager);
+  
+  //chunks of shadow arenas
+  free_shadow_chunks(manager);
+  
   //computation caches
-  free(manager->conjoin_cache);
-  free(manager->disjoin_cache);
+  free_table(manager->conjoin_cache,COMPUTED_CACHE_SIZE,sizeof(SddComputed));
+  free_table(manager->disjoin_cache,COMPUTED_CACHE_SIZE,sizeof(SddComputed));
+  free_table(manager->ite_cache,ITE_CACHE_SIZE,sizeof(SddIteComputed));
+  free_op_cache(&manager->and_exists_cache);
+  free_op_cache(&manager->restrict_cache);
 
   //vtree and its associated structures
   sdd_vtree_free(manager->vtree);
@@ -285,6 +366,7 @@ void sdd_manager_free(SddManager* manager) {
   //manager indices
   free(manager->literals - manager->var_count);
   free(manager->leaf_vtrees);
+  free(manager->var_holds);
 
   //elements stacks
   free(manager->start_compression_stack);
@@ -296,6 +378,14 @@ void sdd_manager_free(SddManager* manager) {
 
   //node buffer
   free(manager->node_buffer);
+  
+  //reference stacks
+  free(manager->start_ref_stack);
+  free(manager->start_deferred_ref_stack);
+  
+  //replacement journal
+  assert(IS_STACK_EMPTY(replacement_journal,manager));
+  free(manager->start_replacement_journal);
  
   assert(manager->stats.element_count==0);
 
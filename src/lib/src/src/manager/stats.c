@@ -74,6 +74,9 @@ void sdd_manager_print(SddManager* manager) {
   printf(                           "   size                     \t:%10s (%.1f MBs)\n",s1=ppc(COMPUTED_CACHE_SIZE),TYPE2MB(2*COMPUTED_CACHE_SIZE,SddComputed)); free(s1);
   printf(                           "   hit rate                 \t:%10.1f%%\n",100.0*manager->computed_cache_hit_count/manager->computed_cache_lookup_count);
   printf(                           "   saturation               \t:%10.1f%%\n",100.0*manager->computed_count/(2*COMPUTED_CACHE_SIZE));
+  printf(                           " computed (ite):\n");
+  printf(                           "   size                     \t:%10s (%.1f MBs)\n",s1=ppc(ITE_CACHE_SIZE),TYPE2MB(ITE_CACHE_SIZE,SddIteComputed)); free(s1);
+  printf(                           "   saturation               \t:%10.1f%%\n",100.0*manager->ite_computed_count/ITE_CACHE_SIZE);
  
   SddManagerVtreeOps ops = manager->vtree_ops;
   printf(                           "\nMINIMIZATION OPTIONS:\n");
@@ -82,6 +85,7 @@ void sdd_manager_print(SddManager* manager) {
   printf(                           " memory limit             \t:%10.1f (min: %.1f MB)\n",ops.op_memory_limit,ops.op_memory_limit>0?VTREE_OP_MEMORY_MIN:0.0);
   printf(                           " cartesian-product limits \t:%10"PRIsS"\n",ops.cartesian_product_limit);
   printf(                           " convergence threshold    \t:%10.1f%%\n",ops.convergence_threshold);
+  printf(                           " exact window             \t:%10"PRIlitS" vars\n",ops.exact_window_var_count);
 
   int icount = manager->auto_search_invocation_count; 
   printf(                           "\nAUTO GC & MINIMIZE      \t:\n");
@@ -93,6 +97,9 @@ void sdd_manager_print(SddManager* manager) {
     printf(                           "   triggers               \t:%10.1f%% global, %.1f%% local, %.1f%% recursive\n",100.0*manager->auto_search_invocation_count_global/icount,100.0*manager->auto_search_invocation_count_local/icount,100.0*manager->auto_search_invocation_count_recursive/icount);
     printf(                           "   average iterations     \t:%10.1f\n",((float)manager->auto_search_iteration_count)/icount);
     printf(                           "   average reduction      \t:%10.1f%%\n",manager->auto_search_reduction_sum/icount);
+    if(manager->auto_search_policy=='g') {
+      printf(                         "   growth thresholds      \t:%10.2f global, %.2f local, %.2f apply\n",manager->auto_global_growth,manager->auto_local_growth,manager->auto_apply_growth);
+    }
     printf(                           "   aborted searches       \t:%10d apply, %d operation, %d fragment, %d search\n",manager->auto_search_invocation_count_aborted_apply,manager->auto_search_invocation_count_aborted_operation,manager->auto_search_invocation_count_aborted_fragment,manager->auto_search_invocation_count_aborted_search);
   }
   
@@ -23,7 +23,9 @@ Vtree* sdd_manager_lca_of_literals(int count, SddLiteral* variables, SddManager*
 
 //vtrees/edit.c
 Vtree* add_var_to_vtree(SddLiteral var, char location, Vtree* sibling, SddManager* manager);
+Vtree* add_vars_to_vtree(SddLiteral first_var, SddLiteral last_var, char location, Vtree* sibling, SddManager* manager);
 void remove_var_from_vtree(SddLiteral var, SddManager* manager);
+void remove_vars_from_vtree(int* keep, SddManager* manager);
 void move_var_in_vtree(SddLiteral var, char var_location, Vtree* new_sibling, SddManager* manager);
 
 /****************************************************************************************
@@ -45,6 +47,27 @@ int sdd_manager_is_var_used(SddLiteral var, SddManager* manager) {
   return (sdd_manager_literal(var,manager))->parent_count > 0 || (sdd_manager_literal(-var,manager))->parent_count > 0;
 }
 
+//holds on a variable keep it from being removed by sdd_manager_remove_unused_vars (literals
+//are not reference counted, so sdd_ref on a literal does not keep its variable)
+//
+//holds are counted in manager->var_holds, which is resized with the variable count and
+//renumbered with the variables
+void sdd_manager_hold_var(SddLiteral var, SddManager* manager) {
+  CHECK_ERROR(var<1 || var>manager->var_count,ERR_MSG_INVALID_VAR,"sdd_manager_hold_var");
+  ++manager->var_holds[var];
+}
+
+void sdd_manager_release_var(SddLiteral var, SddManager* manager) {
+  CHECK_ERROR(var<1 || var>manager->var_count,ERR_MSG_INVALID_VAR,"sdd_manager_release_var");
+  CHECK_ERROR(manager->var_holds[var]==0,"\nerror in %s: more releases than holds of a variable\n","sdd_manager_release_var");
+  --manager->var_holds[var];
+}
+
+static
+int is_var_held(SddLiteral var, SddManager* manager) {
+  return manager->var_holds[var] > 0;
+}
+
 //returns an array map with the following properties:
 //size    : 1+number of variables in manager
 //map[var]: 1 if var is used, 0 otherwise
@@ -98,6 +121,8 @@ void add_var_to_manager(char location, Vtree* sibling, SddManager* manager) {
   //expand the index of leaf vtrees to hold an entry for the new leaf vtree
   //NULL, 1, 2, ..., new_var
   REALLOC(manager->leaf_vtrees,Vtree*,1+new_var_count,"add_var_to_manager");
+  REALLOC(manager->var_holds,SddSize,1+new_var_count,"add_var_to_manager");
+  manager->var_holds[new_var_count] = 0;
 
   //initialization for newly constructed nodes
   
@@ -165,6 +190,59 @@ void add_var_after_lca(int count, SddLiteral* variables, SddManager* manager) {
 }
 
 
+/****************************************************************************************
+ * add vars to a manager
+ *
+ * indices of added variables are 1+largest index of variables in manager, 2+largest
+ * index, ..., count+largest index
+ *
+ * the added variables form a balanced vtree (in the order of their indices) which is
+ * spliced into the manager's vtree as a sibling of an existing vtree node
+ *
+ * the literals and leaf vtrees arrays are expanded once, and vtree positions are
+ * recomputed once, instead of once per variable
+ ****************************************************************************************/
+
+void add_vars_to_manager(SddLiteral count, char location, Vtree* sibling, SddManager* manager) {
+
+  SddLiteral last_var_count = manager->var_count;
+  SddLiteral new_var_count  = manager->var_count += count;
+  assert(last_var_count >= 1);
+
+  //add new vtree to current vtree
+  Vtree* new_vtree = add_vars_to_vtree(last_var_count+1,new_var_count,location,sibling,manager);
+
+  //expand literals array to hold entries for added variables (see add_var_to_manager)
+  SddLiteral last_array_size = 1+2*last_var_count;
+  SddLiteral new_array_size  = 1+2*new_var_count;
+  manager->literals -= last_var_count;
+  REALLOC(manager->literals,SddNode*,new_array_size,"add_vars_to_manager");
+  //shift entries of array forward by count cells
+  memmove(count+manager->literals,manager->literals,last_array_size*sizeof(SddNode*));
+  manager->literals += new_var_count;
+
+  //expand the index of leaf vtrees: NULL, 1, 2, ..., new_var_count
+  REALLOC(manager->leaf_vtrees,Vtree*,1+new_var_count,"add_vars_to_manager");
+  REALLOC(manager->var_holds,SddSize,1+new_var_count,"add_vars_to_manager");
+  memset(manager->var_holds+1+last_var_count,0,count*sizeof(SddSize));
+
+  //construct literal sdds for new leaf nodes and index new leaf vtrees
+  setup_literal_sdds(new_vtree,manager);
+}
+
+//adds count variables
+//if location='l', they are added before (left sibling of) target_var
+//if location='r', they are added after (right sibling of) target_var
+//if target_var is 0, they are added before/after the root of the vtree
+void sdd_manager_add_vars(SddLiteral count, char location, SddLiteral target_var, SddManager* manager) {
+  CHECK_ERROR(location!='l' && location!='r',"\nerror in %s: location must be 'l' or 'r'\n","sdd_manager_add_vars");
+  CHECK_ERROR(target_var<0 || target_var>manager->var_count,"\nerror in %s: invalid target variable\n","sdd_manager_add_vars");
+  if(count<=0) return;
+  Vtree* sibling = target_var==0? manager->vtree: sdd_manager_vtree_of_var(target_var,manager);
+  add_vars_to_manager(count,location,sibling,manager);
+}
+
+
 /****************************************************************************************
  * moving var in a manager
  *
@@ -258,9 +336,113 @@ void remove_var_added_last(SddManager* manager) {
   //shrink the index of leaf vtrees to delete the entry for the removed leaf vtree
   //NULL, 1, 2, ..., last_var-1
   REALLOC(manager->leaf_vtrees,Vtree*,1+new_var_count,"remove_last_var");
+  REALLOC(manager->var_holds,SddSize,1+new_var_count,"remove_last_var");
   
 }
 
+
+/****************************************************************************************
+ * removing unused vars from a manager
+ *
+ * a global gc is performed first, so variables used only by dead nodes become unused
+ *
+ * a variable is unused if its literals have no parents and it is not held (see
+ * sdd_manager_hold_var): literal handles of held variables stay valid
+ *
+ * unused variables are removed from the vtree in one pass (internal vtree nodes left with
+ * one child are collapsed) and their literal sdds are gc'd (see remove_var_added_last);
+ * as literals are not reference counted, it is the user responsibility to hold the
+ * variables of literals they still use
+ *
+ * variables are indexed 1..var_count, so the remaining variables are renumbered densely,
+ * preserving the order of their indices; sdd nodes, ids and computed results are not
+ * affected by the renumbering
+ *
+ * at least one variable is always kept
+ *
+ * wmc and reach managers index their own arrays by variable, so removal is refused while
+ * one exists
+ ****************************************************************************************/
+
+//returns the number of removed variables
+//
+//if renumber_map is not NULL, it must have size 1+var_count (before the call):
+//renumber_map[var] is set to the new index of var, or to 0 if var was removed
+SddLiteral sdd_manager_remove_unused_vars(SddLiteral* renumber_map, SddManager* manager) {
+  CHECK_ERROR(manager->apply_depth,"\nerror in %s: cannot remove variables during an apply\n","sdd_manager_remove_unused_vars");
+  CHECK_ERROR(manager->wmc_manager_count,"\nerror in %s: cannot remove variables while a wmc manager exists\n","sdd_manager_remove_unused_vars");
+  CHECK_ERROR(manager->node_registrations,"\nerror in %s: cannot remove variables while a reach manager exists\n","sdd_manager_remove_unused_vars");
+
+  sdd_vtree_garbage_collect(manager->vtree,manager); //flushes deferred references
+
+  SddLiteral last_var_count = manager->var_count;
+  int* keep = var_usage_map(manager);
+  SddLiteral new_var_count = 0;
+  for(SddLiteral var=1; var<=last_var_count; var++) {
+    if(is_var_held(var,manager)) keep[var] = 1;
+    new_var_count += keep[var];
+  }
+  if(new_var_count==0) { //keep first variable in vtree inorder
+    keep[manager->vtree->first->var] = 1;
+    new_var_count = 1;
+  }
+
+  if(renumber_map) renumber_map[0] = 0;
+  if(new_var_count==last_var_count) {
+    if(renumber_map) for(SddLiteral var=1; var<=last_var_count; var++) renumber_map[var] = var;
+    free(keep);
+    return 0;
+  }
+
+  //gc literal sdds for removed variables (negative literal must be gc'd first)
+  for(SddLiteral var=1; var<=last_var_count; var++) {
+    if(keep[var]) continue;
+    gc_sdd_node(manager->literals[-var],manager);
+    gc_sdd_node(manager->literals[var],manager);
+  }
+
+  //remove leaf nodes of removed variables from vtree
+  remove_vars_from_vtree(keep,manager);
+
+  //renumber remaining variables, and rebuild literals and leaf vtrees arrays
+  SddNode** literals;
+  Vtree** leaf_vtrees;
+  SddSize* var_holds;
+  CALLOC(literals,SddNode*,1+2*new_var_count,"sdd_manager_remove_unused_vars");
+  CALLOC(leaf_vtrees,Vtree*,1+new_var_count,"sdd_manager_remove_unused_vars");
+  CALLOC(var_holds,SddSize,1+new_var_count,"sdd_manager_remove_unused_vars");
+  literals += new_var_count; //position pointer at 0
+
+  SddLiteral new_var = 0;
+  for(SddLiteral var=1; var<=last_var_count; var++) {
+    if(renumber_map) renumber_map[var] = keep[var]? new_var+1: 0;
+    if(!keep[var]) continue;
+    ++new_var;
+    SddNode* plit       = manager->literals[var];
+    SddNode* nlit       = manager->literals[-var];
+    Vtree* leaf         = manager->leaf_vtrees[var];
+    plit->alpha.literal = new_var;
+    nlit->alpha.literal = -new_var;
+    leaf->var           = new_var;
+    literals[new_var]   = plit;
+    literals[-new_var]  = nlit;
+    leaf_vtrees[new_var] = leaf;
+    var_holds[new_var]   = manager->var_holds[var];
+  }
+  assert(new_var==new_var_count);
+
+  free(manager->literals-last_var_count);
+  free(manager->leaf_vtrees);
+  free(manager->var_holds);
+  manager->literals    = literals;
+  manager->leaf_vtrees = leaf_vtrees;
+  manager->var_holds   = var_holds;
+  manager->var_count   = new_var_count;
+
+  free(keep);
+  return last_var_count-new_var_count;
+}
+
  
 /****************************************************************************************
  * end
@@ -0,0 +1,145 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//sdds/apply.c
+SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, int limited);
+SddElement* partition_for_vtree(SddNode* node, Vtree* vtree, SddElement* elements, SddNodeSize* size, SddManager* manager);
+
+/****************************************************************************************
+ * conjoin two sdds and existentially quantify a number of variables from the result
+ * (relational product), without constructing the conjunction
+ *
+ * let vtree be the lca of f and g, (pi,si) and (qj,tj) the elements of f and g as
+ * partitions for vtree (see ite in apply.c), and XL, XR the quantified variables of
+ * vtree->left and vtree->right:
+ *
+ *   exists X (f and g) = OR_ij [exists XL (pi and qj)] and [exists XR (si and tj)]
+ *
+ * --if no variable of vtree is quantified: f and g are conjoined
+ * --if XL is empty: the primes (pi and qj) form a partition, so the result is constructed
+ *   as a decomposition whose subs are computed recursively
+ * --otherwise: the disjunction is accumulated, stopping once it becomes true. when all
+ *   variables of vtree are quantified, each term is true or false, so vtree collapses
+ *   immediately (at the first consistent element)
+ *
+ * results depend on the quantified variables, so each call starts a new context of the
+ * and_exists cache of the manager (see computed.c)
+ *
+ * will not do auto gc/minimize as its computations are done in no-auto mode
+ ****************************************************************************************/
+
+typedef struct {
+  SddLiteral* q_counts; //q_counts[p]: number of quantified leaves with position < p
+} AndExists;
+
+//local declarations
+static SddNode* and_exists(SddNode* node1, SddNode* node2, AndExists* ae, SddManager* manager);
+
+//exists_map is an array with the following properties:
+//size             : 1+number of variables in manager
+//exists_map[var]  : is 1 if var is to be existentially quantified, 0 otherwise
+//exists_map[0]    : not used
+
+SddNode* sdd_and_exists(SddNode* node1, SddNode* node2, int* exists_map, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(node1),ERR_MSG_GC,"sdd_and_exists");
+  CHECK_ERROR(GC_NODE(node2),ERR_MSG_GC,"sdd_and_exists");
+
+  AndExists ae;
+  Vtree* root = manager->vtree;
+  SddLiteral position_count = 1+root->last->position;
+  CALLOC(ae.q_counts,SddLiteral,1+position_count,"sdd_and_exists");
+  FOR_each_vtree_node(v,root,{
+    SddLiteral p = v->position;
+    ae.q_counts[p+1] = ae.q_counts[p]+(LEAF(v) && exists_map[v->var]);
+  });
+  new_op_context(&manager->and_exists_cache);
+
+  SddNode* node;
+  WITH_no_auto_mode(manager,{
+    node = and_exists(node1,node2,&ae,manager);
+  });
+
+  free(ae.q_counts);
+  return node;
+}
+
+//number of quantified variables in vtree
+static inline
+SddLiteral q_count_of(Vtree* vtree, AndExists* ae) {
+  return ae->q_counts[1+vtree->last->position]-ae->q_counts[vtree->first->position];
+}
+
+//node1 and node2 are normalized for arbitrary vtrees
+static
+SddNode* and_exists(SddNode* node1, SddNode* node2, AndExists* ae, SddManager* manager) {
+  if(IS_FALSE(node1) || IS_FALSE(node2)) return manager->false_sdd;
+  if(node1==node2->negation) return manager->false_sdd;
+  if(node1==node2) node2 = manager->true_sdd;
+  if(IS_TRUE(node1)) SWAP(SddNode*,node1,node2);
+  if(IS_TRUE(node1)) return manager->true_sdd; //both true
+  //node1 is not trivial, node2 may be true: exists X (node1)
+
+  Vtree* vtree = IS_TRUE(node2)? node1->vtree: sdd_vtree_lca(node1->vtree,node2->vtree,manager->vtree);
+  SddLiteral q_count = q_count_of(vtree,ae);
+  if(q_count==0) return apply(node1,node2,CONJOIN,manager,0);
+  if(LEAF(vtree)) return manager->true_sdd; //consistent literals of a quantified variable
+
+  if(node1->id > node2->id) SWAP(SddNode*,node1,node2); //for hash key
+  SddNode* node = lookup_op_computation(node1->id,node2->id,&manager->and_exists_cache,manager);
+  if(node!=NULL) return node; //cache hit
+
+  SddElement storage1[2], storage2[2];
+  SddNodeSize size1, size2;
+  SddElement* elements1 = IS_TRUE(node1)? NULL: partition_for_vtree(node1,vtree,storage1,&size1,manager);
+  SddElement* elements2 = IS_TRUE(node2)? NULL: partition_for_vtree(node2,vtree,storage2,&size2,manager);
+  if(elements1==NULL) { //true as a partition for vtree
+    storage1[0].prime = storage1[0].sub = manager->true_sdd;
+    elements1 = storage1;
+    size1     = 1;
+  }
+  if(elements2==NULL) {
+    storage2[0].prime = storage2[0].sub = manager->true_sdd;
+    elements2 = storage2;
+    size2     = 1;
+  }
+
+  if(q_count_of(vtree->left,ae)==0) { //primes are not quantified: a partition
+    //NOTE: compression is possible here (i.e., apply may be called)
+    GET_node_from_partition(node,vtree,manager,{
+      for(SddElement* e1=elements1; e1<elements1+size1; e1++) {
+        for(SddElement* e2=elements2; e2<elements2+size2; e2++) {
+          SddNode* prime = apply(e1->prime,e2->prime,CONJOIN,manager,0);
+          if(IS_FALSE(prime)) continue;
+          SddNode* sub = and_exists(e1->sub,e2->sub,ae,manager);
+          DECLARE_element(prime,sub,vtree,manager);
+        }
+      }
+    });
+  }
+  else { //disjoin the quantified elements
+    node = manager->false_sdd;
+    for(SddElement* e1=elements1; e1<elements1+size1 && !IS_TRUE(node); e1++) {
+      for(SddElement* e2=elements2; e2<elements2+size2 && !IS_TRUE(node); e2++) {
+        SddNode* sub = and_exists(e1->sub,e2->sub,ae,manager);
+        if(IS_FALSE(sub)) continue;
+        SddNode* prime = and_exists(e1->prime,e2->prime,ae,manager);
+        if(IS_FALSE(prime)) continue;
+        SddNode* element = apply(prime,sub,CONJOIN,manager,0);
+        node = apply(node,element,DISJOIN,manager,0);
+      }
+    }
+  }
+  assert(node!=NULL);
+
+  cache_op_computation(node1->id,node2->id,node,&manager->and_exists_cache,manager);
+  return node;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
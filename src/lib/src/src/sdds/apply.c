@@ -24,6 +24,7 @@ char cmp_vtrees(Vtree** lca, Vtree* vtree1, Vtree* vtree2);
 
 //local declarations
 SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, int limited);
+static SddNode* ite(SddNode* f, SddNode* g, SddNode* h, SddManager* manager);
 
 /****************************************************************************************
  * macros for protecting nodes
@@ -233,6 +234,76 @@ SddNode* sdd_apply_incomparable(SddNode* node1, SddNode* node2, BoolOp op, Vtree
   return node;
 }
 
+/****************************************************************************************
+ * apply case 5: vtree->left is a leaf (e.g., every internal node of a right-linear vtree)
+ *
+ * primes are then literals of the leaf variable x, so each node is viewed as a shannon
+ * expansion (x,hi), (~x,lo) and the result is (x,hi1 op hi2), (~x,lo1 op lo2): two
+ * recursive applies instead of multiplying decompositions, and no compression since
+ * the two subs are either equal (trimming) or distinct
+ ****************************************************************************************/
+
+//node is normalized for vtree, vtree->left or a sub_vtree of vtree->right
+static inline
+void shannon_cofactors(SddNode* node, Vtree* vtree, SddNode** hi, SddNode** lo, SddManager* manager) {
+  if(node->vtree==vtree) { //two elements with primes x and ~x
+    assert(node->size==2);
+    SddElement* elements = ELEMENTS_OF(node);
+    int i = LITERAL_OF(elements[0].prime)>0? 0: 1;
+    *hi = elements[i].sub;
+    *lo = elements[1-i].sub;
+  }
+  else if(node->vtree==vtree->left) { //literal of x
+    int positive = LITERAL_OF(node)>0;
+    *hi = positive? manager->true_sdd: manager->false_sdd;
+    *lo = positive? manager->false_sdd: manager->true_sdd;
+  }
+  else *hi = *lo = node; //independent of x
+}
+
+//node1 and node2 are normalized for vtree or sub_vtrees of vtree (not both for vtree->left)
+//vtree->left is a leaf
+//result is normalized for vtree unless it was trimmed
+static
+SddNode* sdd_apply_shannon(SddNode* node1, SddNode* node2, BoolOp op, Vtree* vtree, SddManager* manager, int limited) {
+  assert(node1!=NULL && node2!=NULL);
+  assert(NON_TRIVIAL(node1) && NON_TRIVIAL(node2));
+  assert(LEAF(vtree->left));
+
+  SddNode *hi1, *lo1, *hi2, *lo2;
+  shannon_cofactors(node1,vtree,&hi1,&lo1,manager);
+  shannon_cofactors(node2,vtree,&hi2,&lo2,manager);
+
+  c_ref(node1,manager); c_ref(node2,manager); //protect
+
+  //vtree will not change, but vtree->right may change
+  SddNode* lo = NULL;
+  SddNode* hi = apply(hi1,hi2,op,manager,limited); //could be NULL
+  if(hi!=NULL) {
+    c_ref(hi,manager); //protect
+    lo = apply(lo1,lo2,op,manager,limited); //could be NULL
+    c_deref(hi,manager); //release
+  }
+
+  c_deref(node1,manager); c_deref(node2,manager); //release
+
+  if(lo==NULL) return NULL;
+  if(hi==lo) return hi; //trimming
+  SddLiteral var = vtree->left->var;
+  if(IS_TRUE(hi) && IS_FALSE(lo)) return sdd_manager_literal(var,manager); //trimming
+  if(IS_FALSE(hi) && IS_TRUE(lo)) return sdd_manager_literal(-var,manager); //trimming
+
+  SddNode* node;
+  //NOTE: no compression is possible here (i.e., apply will not be called)
+  GET_node_from_compressed_partition(node,vtree,manager,{
+    DECLARE_compressed_element(sdd_manager_literal(var,manager),hi,vtree,manager);
+    DECLARE_compressed_element(sdd_manager_literal(-var,manager),lo,vtree,manager);
+  });
+
+  assert(node!=NULL);
+  return node;
+}
+
 /****************************************************************************************
  * apply master: channel to one of the above cases
  ****************************************************************************************/
@@ -251,6 +322,7 @@ int root_limited_apply(SddManager* manager) {
 //book keeping when starting an apply that could invoke vtree search
 static inline
 void prepare_for_vtree_search(Vtree* lca, SddManager* manager) {
+  sdd_manager_flush_deferred_refs(manager); //baselines depend on exact live/dead counts
   manager->auto_apply_vtree              = lca;
   manager->auto_apply_outside_live_size  = (manager->sdd_size-manager->dead_sdd_size);
   manager->auto_apply_outside_live_count = (manager->node_count-manager->dead_node_count);
@@ -263,18 +335,29 @@ void prepare_for_vtree_search(Vtree* lca, SddManager* manager) {
 }
 
 //not limited: vtree search possible
+//top-level applies are timed for the adaptive search policy, excluding the time of searches
+//they invoke (see vtree_search/auto.c)
 static
 SddNode* u_apply(char apply_type, Vtree* lca, SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager) {
-  if(manager->auto_gc_and_search_on && root_apply(manager)) prepare_for_vtree_search(lca,manager);
+  int top   = manager->auto_gc_and_search_on && root_apply(manager);
+  int timed = top && manager->auto_search_policy=='g';
+  clock_t start_time = 0, start_search_time = 0;
+  if(top) prepare_for_vtree_search(lca,manager);
+  if(timed) {
+    start_time        = clock();
+    start_search_time = manager->stats.auto_search_time;
+  }
   SddNode* node = NULL;
   switch(apply_type) {
     case 'e': node = sdd_apply_equal(node1,node2,op,lca,manager,0); break;
     case 'l': node = sdd_apply_left(node1,node2,op,lca,manager,0); break;
     case 'r': node = sdd_apply_right(node1,node2,op,lca,manager,0); break;
     case 'i': node = sdd_apply_incomparable(node1,node2,op,lca,manager,0); break;
+    case 's': node = sdd_apply_shannon(node1,node2,op,lca,manager,0); break;
     default: assert(0); 
   }
   assert(node);  
+  if(timed) manager->auto_apply_time += (clock()-start_time)-(manager->stats.auto_search_time-start_search_time);
   cache_computation(node1,node2,node,op,manager);
   if(manager->auto_gc_and_search_on && lca->var_count > 1) {
     sdd_ref(node,manager); //same as c_ref
@@ -295,6 +378,7 @@ SddNode* l_apply(char apply_type, Vtree* lca, SddNode* node1, SddNode* node2, Bo
     case 'l': node = sdd_apply_left(node1,node2,op,lca,manager,1); break;
     case 'r': node = sdd_apply_right(node1,node2,op,lca,manager,1); break;
     case 'i': node = sdd_apply_incomparable(node1,node2,op,lca,manager,1); break;
+    case 's': node = sdd_apply_shannon(node1,node2,op,lca,manager,1); break;
     default: assert(0); 
   }
   if(node) {
@@ -338,6 +422,7 @@ SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, i
   Vtree* lca      = NULL; //lowest common ancestor
   char apply_type = cmp_vtrees(&lca,node1->vtree,node2->vtree);
   //(ab) + (a~b) = a, which is why node->vtree!=lca in general
+  if(INTERNAL(lca) && LEAF(lca->left)) apply_type = 's'; //primes are literals: shannon expansion
 
   node = limited? l_apply(apply_type,lca,node1,node2,op,manager):
                   u_apply(apply_type,lca,node1,node2,op,manager);
@@ -346,6 +431,138 @@ SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, i
   return node;
 }
 
+/****************************************************************************************
+ * if-then-else: ite(f,g,h) = (f and g) or (not f and h)
+ *
+ * f, g and h are normalized for sub_vtrees of vtree, the lca of their vtrees; each is 
+ * viewed as a partition for vtree:
+ * --node normalized for vtree: its elements
+ * --node normalized for a sub_vtree of vtree->left: (node,true), (~node,false)
+ * --node normalized for a sub_vtree of vtree->right: (true,node)
+ *
+ * the result is the product of the three partitions: for each consistent combination of
+ * primes, the sub is the ite of the corresponding subs (one recursion over the three
+ * arguments instead of separate applies whose intermediate results are discarded)
+ *
+ * the recursion is done in no-auto mode; auto gc/minimize may take place once the
+ * top-level ite has finished, as for a top-level apply
+ ****************************************************************************************/
+
+//ite(f,g,h) when one apply suffices (or none), NULL otherwise
+static
+SddNode* ite_base(SddNode* f, SddNode* g, SddNode* h, SddManager* manager) {
+  if(IS_TRUE(f))  return g;
+  if(IS_FALSE(f)) return h;
+  if(g==h)        return g;
+  if(IS_TRUE(g)  || g==f) return apply(f,h,DISJOIN,manager,0);
+  if(IS_FALSE(h) || h==f) return apply(f,g,CONJOIN,manager,0);
+  if(IS_FALSE(g) || g==f->negation) return apply(sdd_negate(f,manager),h,CONJOIN,manager,0);
+  if(IS_TRUE(h)  || h==f->negation) return apply(sdd_negate(f,manager),g,DISJOIN,manager,0);
+  return NULL;
+}
+
+//f, g and h are normalized for arbitrary vtrees
+SddNode* sdd_ite(SddNode* f, SddNode* g, SddNode* h, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(f),ERR_MSG_GC,"sdd_ite");
+  CHECK_ERROR(GC_NODE(g),ERR_MSG_GC,"sdd_ite");
+  CHECK_ERROR(GC_NODE(h),ERR_MSG_GC,"sdd_ite");
+
+  SddNode* node = ite_base(f,g,h,manager); //top-level apply: auto mode applies
+  if(node!=NULL) return node;
+
+  //the ite counts as one apply: applies it recurses into are not top-level
+  ++manager->apply_depth;
+  ++manager->stats.apply_count;
+  if(root_apply(manager)) ++manager->stats.apply_count_top;
+
+  Vtree* root = manager->vtree;
+  Vtree* lca  = sdd_vtree_lca(sdd_vtree_lca(f->vtree,g->vtree,root),h->vtree,root);
+  int top     = manager->auto_gc_and_search_on && root_apply(manager);
+  int timed   = top && manager->auto_search_policy=='g';
+  clock_t start_time = 0;
+  if(top) prepare_for_vtree_search(lca,manager);
+  if(timed) start_time = clock();
+
+  WITH_no_auto_mode(manager,{
+    node = ite(f,g,h,manager);
+  });
+  assert(node!=NULL);
+
+  if(timed) manager->auto_apply_time += clock()-start_time;
+  if(top && lca->var_count > 1) { //same book keeping as a top-level u_apply
+    sdd_ref(node,manager);
+    try_auto_gc_and_minimize(lca,manager);
+    sdd_deref(node,manager);
+  }
+  --manager->apply_depth;
+  return node;
+}
+
+//the elements of node as a partition for vtree (see above)
+//elements is used as storage when node is not normalized for vtree
+//node is not trivial and normalized for a sub_vtree of vtree
+SddElement* partition_for_vtree(SddNode* node, Vtree* vtree, SddElement* elements, SddNodeSize* size, SddManager* manager) {
+  if(node->vtree==vtree) {
+    *size = node->size;
+    return ELEMENTS_OF(node);
+  }
+  else if(sdd_vtree_is_sub(node->vtree,vtree->left)) {
+    *size = 2;
+    elements[0].prime = node;
+    elements[0].sub   = manager->true_sdd;
+    elements[1].prime = sdd_negate(node,manager);
+    elements[1].sub   = manager->false_sdd;
+  }
+  else {
+    assert(sdd_vtree_is_sub(node->vtree,vtree->right));
+    *size = 1;
+    elements[0].prime = manager->true_sdd;
+    elements[0].sub   = node;
+  }
+  return elements;
+}
+
+static
+SddNode* ite(SddNode* f, SddNode* g, SddNode* h, SddManager* manager) {
+  assert(!GC_NODE(f) && !GC_NODE(g) && !GC_NODE(h));
+
+  SddNode* node = ite_base(f,g,h,manager);
+  if(node!=NULL) return node;
+  //f, g and h are not trivial
+
+  node = lookup_ite_computation(f,g,h,manager);
+  if(node!=NULL) return node; //cache hit
+
+  Vtree* root  = manager->vtree;
+  Vtree* vtree = sdd_vtree_lca(sdd_vtree_lca(f->vtree,g->vtree,root),h->vtree,root);
+  
+  SddElement f_storage[2], g_storage[2], h_storage[2];
+  SddNodeSize f_size, g_size, h_size;
+  SddElement* f_elements = partition_for_vtree(f,vtree,f_storage,&f_size,manager);
+  SddElement* g_elements = partition_for_vtree(g,vtree,g_storage,&g_size,manager);
+  SddElement* h_elements = partition_for_vtree(h,vtree,h_storage,&h_size,manager);
+
+  //NOTE: compression is possible here (i.e., apply may be called)
+  GET_node_from_partition(node,vtree,manager,{
+    for(SddElement* fe=f_elements; fe<f_elements+f_size; fe++) {
+      for(SddElement* ge=g_elements; ge<g_elements+g_size; ge++) {
+        SddNode* fg_prime = apply(fe->prime,ge->prime,CONJOIN,manager,0);
+        if(IS_FALSE(fg_prime)) continue;
+        for(SddElement* he=h_elements; he<h_elements+h_size; he++) {
+          SddNode* prime = apply(fg_prime,he->prime,CONJOIN,manager,0);
+          if(IS_FALSE(prime)) continue;
+          SddNode* sub = ite(fe->sub,ge->sub,he->sub,manager);
+          DECLARE_element(prime,sub,vtree,manager);
+        }
+      }
+    }
+  });
+  assert(node!=NULL);
+
+  cache_ite_computation(f,g,h,node,manager);
+  return node;
+}
+
 /****************************************************************************************
  * special case of sdd_apply used by left/right rotations
  *
@@ -0,0 +1,137 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//sdds/apply.c
+SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, int limited);
+
+//local declarations
+static void initialize_map(SddNode* node, SddNode** compose_map);
+static void compose_aux(SddNode* node, SddNode** compose_map, SddManager* manager);
+
+/****************************************************************************************
+ * functional composition: substitute sdds for variables
+ *
+ * substitution distributes over the elements of a decomposition, and maps a partition
+ * into a partition (primes stay mutually exclusive and exhaustive), so
+ *
+ *   compose(OR_i pi and si) = OR_i compose(pi) and compose(si)
+ *
+ * which, for two elements, is ite(compose(p1),compose(s1),compose(s2))
+ *
+ * each node is composed once (node->map holds its composition, as in rename_vars.c), and
+ * nodes that mention no substituted variable are their own composition
+ *
+ * will not do auto gc/minmize as its computations are done in no-auto mode
+ ****************************************************************************************/
+
+//compose_map is an array with the following properties:
+//size              : 1+number of variables in manager
+//compose_map[var]  : sdd substituted for var, or NULL if var is not substituted
+//compose_map[0]    : not used
+//
+//all variables are substituted simultaneously
+SddNode* sdd_vector_compose(SddNode* node, SddNode** compose_map, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(node),ERR_MSG_GC,"sdd_vector_compose");
+  for(SddLiteral var=1; var<=manager->var_count; var++) {
+    CHECK_ERROR(compose_map[var] && GC_NODE(compose_map[var]),ERR_MSG_GC,"sdd_vector_compose");
+  }
+
+  if(node->type==FALSE || node->type==TRUE) return node;
+  //node is not trivial
+
+  WITH_no_auto_mode(manager,{
+    initialize_map(node,compose_map);
+    compose_aux(node,compose_map,manager);
+  });
+
+  return node->map;
+}
+
+//substitutes sdd g for variable var in node
+SddNode* sdd_compose(SddNode* node, SddLiteral var, SddNode* g, SddManager* manager) {
+  CHECK_ERROR(var<1 || var>manager->var_count,"\nerror in %s: invalid variable\n","sdd_compose");
+  SddNode** compose_map;
+  CALLOC(compose_map,SddNode*,1+manager->var_count,"sdd_compose");
+  compose_map[var] = g;
+  SddNode* composition = sdd_vector_compose(node,compose_map,manager);
+  free(compose_map);
+  return composition;
+}
+
+//compute node compositions and store them in the map field
+static
+void compose_aux(SddNode* node, SddNode** compose_map, SddManager* manager) {
+  if(node->map!=NULL) return;
+
+  SddNode* node_map;
+
+  if(node->type==LITERAL) { //must be substituted
+    SddNode* g = compose_map[VAR_OF(node)];
+    assert(g!=NULL);
+    node_map = LITERAL_OF(node)>0? g: sdd_negate(g,manager);
+  }
+  else { //decomposition
+    FOR_each_prime_sub_of_node(prime,sub,node,{
+      compose_aux(prime,compose_map,manager);
+      compose_aux(sub,compose_map,manager);
+    });
+    if(node->size==2) {
+      SddElement* elements = ELEMENTS_OF(node);
+      node_map = sdd_ite(elements[0].prime->map,elements[0].sub->map,elements[1].sub->map,manager);
+    }
+    else {
+      node_map = manager->false_sdd;
+      FOR_each_prime_sub_of_node(prime,sub,node,{
+        SddNode* element_map = apply(prime->map,sub->map,CONJOIN,manager,0);
+        node_map = apply(node_map,element_map,DISJOIN,manager,0);
+      });
+    }
+  }
+
+  node->map = node_map;
+}
+
+/****************************************************************************************
+ * initialize the map field of nodes:
+ *
+ * node->map=node if node does not include a substituted var
+ * node->map=NULL otherwise
+ ****************************************************************************************/
+
+//this function will leave all bits of nodes set to 1
+static
+void initialize_map_aux(SddNode* node, SddNode** compose_map) {
+  if(node->bit) return; //node visited before
+  node->bit = 1;
+
+  node->map = NULL; //default
+
+  if(node->type==FALSE || node->type==TRUE) node->map = node;
+  else if(node->type==LITERAL) {
+    if(compose_map[VAR_OF(node)]==NULL) node->map = node;
+  }
+  else { //decomposition
+    int compose = 0;
+    FOR_each_prime_sub_of_node(prime,sub,node,{
+      initialize_map_aux(prime,compose_map);
+      initialize_map_aux(sub,compose_map);
+      compose = compose || prime->map==NULL || sub->map==NULL;
+    });
+    if(compose==0) node->map = node;
+  }
+}
+
+static
+void initialize_map(SddNode* node, SddNode** compose_map) {
+  initialize_map_aux(node,compose_map);
+  sdd_clear_node_bits(node);
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
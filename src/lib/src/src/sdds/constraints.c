@@ -0,0 +1,341 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+/****************************************************************************************
+ * constructing sdds for linear constraints and parity directly over the manager's vtree
+ *
+ * for a linear constraint with weights w, let sum(v) be the weighted sum of the variables
+ * in vtree v, and S(v) the set of its achievable values. the sdd for lo <= sum(v) <= hi is
+ *
+ *   OR_s [sum(v->left)=s] and [lo-s <= sum(v->right) <= hi-s],  for s in S(v->left)
+ *
+ * intervals are snapped to achievable values (so equal functions have equal intervals),
+ * consecutive values of s whose sub intervals are equal are grouped into one prime (an
+ * interval of v->left), and the resulting partition is compressed if needed. vtrees
+ * with no constrained variables (S(v)={0}) are skipped. sdds are cached by vtree and
+ * snapped interval
+ *
+ * for parity, odd(v) has elements (odd(v->left),even(v->right)), (even(v->left),odd(v->right))
+ *
+ * will not do auto gc/minimize as its computations are done in no-auto mode
+ ****************************************************************************************/
+
+typedef struct interval_computed_t {
+  Vtree* vtree;
+  SddLiteral lo;
+  SddLiteral hi;
+  SddNode* node;
+  struct interval_computed_t* next;
+} IntervalComputed;
+
+typedef struct {
+  SddLiteral* weights;
+  SddLiteral** sums; //sums[p]: sorted achievable values of vtree with position p
+  SddLiteral* sum_counts;
+  IntervalComputed** cache;
+} Linear;
+
+//local declarations
+static SddNode* linear_interval(SddLiteral* weights, SddLiteral lo, SddLiteral hi, SddManager* manager);
+static SddNode* interval(Vtree* vtree, SddLiteral lo, SddLiteral hi, Linear* linear, SddManager* manager);
+
+//vars is an array of size count
+
+SddNode* sdd_at_most_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager) {
+  SddLiteral* weights;
+  CALLOC(weights,SddLiteral,1+manager->var_count,"sdd_at_most_k");
+  for(SddLiteral i=0; i<count; i++) {
+    CHECK_ERROR(vars[i]<1 || vars[i]>manager->var_count,"\nerror in %s: invalid variable\n","sdd_at_most_k");
+    weights[vars[i]] = 1;
+  }
+  SddNode* node = linear_interval(weights,0,k,manager);
+  free(weights);
+  return node;
+}
+
+SddNode* sdd_at_least_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager) {
+  SddLiteral* weights;
+  CALLOC(weights,SddLiteral,1+manager->var_count,"sdd_at_least_k");
+  for(SddLiteral i=0; i<count; i++) {
+    CHECK_ERROR(vars[i]<1 || vars[i]>manager->var_count,"\nerror in %s: invalid variable\n","sdd_at_least_k");
+    weights[vars[i]] = 1;
+  }
+  SddNode* node = linear_interval(weights,k,count,manager);
+  free(weights);
+  return node;
+}
+
+SddNode* sdd_exactly_k(SddLiteral k, SddLiteral count, SddLiteral* vars, SddManager* manager) {
+  SddLiteral* weights;
+  CALLOC(weights,SddLiteral,1+manager->var_count,"sdd_exactly_k");
+  for(SddLiteral i=0; i<count; i++) {
+    CHECK_ERROR(vars[i]<1 || vars[i]>manager->var_count,"\nerror in %s: invalid variable\n","sdd_exactly_k");
+    weights[vars[i]] = 1;
+  }
+  SddNode* node = linear_interval(weights,k,k,manager);
+  free(weights);
+  return node;
+}
+
+static inline
+SddLiteral gcd_of(SddLiteral a, SddLiteral b) {
+  while(b) { SddLiteral r = a%b; a = b; b = r; }
+  return a;
+}
+
+//weights is an array with the following properties:
+//size          : 1+number of variables in manager
+//weights[var]  : weight of var (0 if var is not constrained), at most MAX_LINEAR_WEIGHT
+//                in absolute value (so sums cannot overflow)
+//weights[0]    : not used
+//
+//weights are divided by their gcd (and the bound rounded down accordingly), so a scaled
+//constraint is constructed over the same sums as the original one
+//
+//returns an sdd for: sum of weights[var]*var <= bound
+SddNode* sdd_linear_leq(SddLiteral* weights, SddLiteral bound, SddManager* manager) {
+  SddLiteral min = 0; //smallest achievable sum
+  SddLiteral max = 0; //largest achievable sum
+  SddLiteral gcd = 0;
+  for(SddLiteral var=1; var<=manager->var_count; var++) {
+    SddLiteral w = weights[var];
+    CHECK_ERROR(w>MAX_LINEAR_WEIGHT || w<-MAX_LINEAR_WEIGHT,"\nerror in %s: weight too large\n","sdd_linear_leq");
+    if(w<0) min += w;
+    else max += w;
+    gcd = gcd_of(gcd,w<0? -w: w);
+  }
+  if(bound<min) return manager->false_sdd;
+  if(bound>=max) return manager->true_sdd;
+
+  SddLiteral* normalized;
+  CALLOC(normalized,SddLiteral,1+manager->var_count,"sdd_linear_leq");
+  for(SddLiteral var=1; var<=manager->var_count; var++) normalized[var] = weights[var]/gcd;
+  //min is a multiple of gcd, and min <= bound < max
+  SddLiteral lo = min/gcd;
+  SddLiteral hi = lo+(bound-min)/gcd; //bound rounded down to an achievable multiple
+  SddNode* node = linear_interval(normalized,lo,hi,manager);
+  free(normalized);
+  return node;
+}
+
+/****************************************************************************************
+ * achievable sums
+ ****************************************************************************************/
+
+static
+int literal_cmp(const void* a, const void* b) {
+  SddLiteral x = *(const SddLiteral*)a;
+  SddLiteral y = *(const SddLiteral*)b;
+  return (x>y)-(x<y);
+}
+
+static
+void compute_sums(Vtree* vtree, Linear* linear) {
+  SddLiteral p = vtree->position;
+  SddLiteral* sums;
+  SddLiteral count;
+  if(LEAF(vtree)) {
+    SddLiteral w = linear->weights[vtree->var];
+    count = w==0? 1: 2;
+    CALLOC(sums,SddLiteral,count,"compute_sums");
+    if(w<0) sums[0] = w;
+    else if(w>0) sums[1] = w;
+  }
+  else {
+    compute_sums(vtree->left,linear);
+    compute_sums(vtree->right,linear);
+    SddLiteral lp = vtree->left->position;
+    SddLiteral rp = vtree->right->position;
+    SddLiteral lc = linear->sum_counts[lp];
+    SddLiteral rc = linear->sum_counts[rp];
+    CALLOC(sums,SddLiteral,lc*rc,"compute_sums");
+    count = 0;
+    for(SddLiteral i=0; i<lc; i++) {
+      for(SddLiteral j=0; j<rc; j++) sums[count++] = linear->sums[lp][i]+linear->sums[rp][j];
+    }
+    qsort(sums,count,sizeof(SddLiteral),literal_cmp);
+    SddLiteral unique = 1;
+    for(SddLiteral i=1; i<count; i++) if(sums[i]!=sums[unique-1]) sums[unique++] = sums[i];
+    count = unique;
+  }
+  linear->sums[p]       = sums;
+  linear->sum_counts[p] = count;
+}
+
+//index of first sum >= lo
+static
+SddLiteral first_sum(SddLiteral lo, SddLiteral* sums, SddLiteral count) {
+  SddLiteral i = 0, j = count;
+  while(i<j) {
+    SddLiteral m = i+(j-i)/2;
+    if(sums[m]<lo) i = m+1; else j = m;
+  }
+  return i;
+}
+
+//index of last sum <= hi (-1 if none)
+static
+SddLiteral last_sum(SddLiteral hi, SddLiteral* sums, SddLiteral count) {
+  SddLiteral i = 0, j = count;
+  while(i<j) {
+    SddLiteral m = i+(j-i)/2;
+    if(sums[m]<=hi) i = m+1; else j = m;
+  }
+  return i-1;
+}
+
+/****************************************************************************************
+ * intervals
+ ****************************************************************************************/
+
+//returns an sdd for: lo <= sum of weights[var]*var <= hi
+static
+SddNode* linear_interval(SddLiteral* weights, SddLiteral lo, SddLiteral hi, SddManager* manager) {
+  Vtree* root = manager->vtree;
+  SddLiteral position_count = 1+root->last->position;
+
+  Linear linear;
+  linear.weights = weights;
+  CALLOC(linear.sums,SddLiteral*,position_count,"linear_interval");
+  CALLOC(linear.sum_counts,SddLiteral,position_count,"linear_interval");
+  CALLOC(linear.cache,IntervalComputed*,LINEAR_CACHE_SIZE,"linear_interval");
+  compute_sums(root,&linear);
+
+  SddNode* node;
+  WITH_no_auto_mode(manager,{
+    node = interval(root,lo,hi,&linear,manager);
+  });
+
+  for(SddLiteral p=0; p<position_count; p++) free(linear.sums[p]);
+  for(SddSize i=0; i<LINEAR_CACHE_SIZE; i++) {
+    IntervalComputed* c = linear.cache[i];
+    while(c) {
+      IntervalComputed* next = c->next;
+      free(c);
+      c = next;
+    }
+  }
+  free(linear.sums);
+  free(linear.sum_counts);
+  free(linear.cache);
+  return node;
+}
+
+static
+SddNode* interval(Vtree* vtree, SddLiteral lo, SddLiteral hi, Linear* linear, SddManager* manager) {
+  SddLiteral* sums = linear->sums[vtree->position];
+  SddLiteral count = linear->sum_counts[vtree->position];
+  SddLiteral i     = first_sum(lo,sums,count);
+  SddLiteral j     = last_sum(hi,sums,count);
+  if(i>j) return manager->false_sdd;
+  if(i==0 && j==count-1) return manager->true_sdd;
+  lo = sums[i];
+  hi = sums[j];
+  //count>1 and some achievable sum is outside [lo,hi]
+
+  if(LEAF(vtree)) { //[lo,hi] contains exactly one of 0 and the weight
+    SddLiteral var = vtree->var;
+    return sdd_manager_literal(lo==0? -var: var,manager);
+  }
+  SddLiteral lp = vtree->left->position;
+  SddLiteral rp = vtree->right->position;
+  if(linear->sum_counts[lp]==1) return interval(vtree->right,lo,hi,linear,manager);
+  if(linear->sum_counts[rp]==1) return interval(vtree->left,lo,hi,linear,manager);
+
+  SddSize key = ((SddSize)(16777619*vtree->position)^(SddSize)(31*lo)^(SddSize)hi) % LINEAR_CACHE_SIZE;
+  for(IntervalComputed* c=linear->cache[key]; c; c=c->next) {
+    if(c->vtree==vtree && c->lo==lo && c->hi==hi) return c->node;
+  }
+
+  SddLiteral* l_sums = linear->sums[lp];
+  SddLiteral l_count = linear->sum_counts[lp];
+  SddLiteral* r_sums = linear->sums[rp];
+  SddLiteral r_count = linear->sum_counts[rp];
+
+  SddNode* node;
+  //NOTE: compression is possible here (i.e., apply may be called)
+  GET_node_from_partition(node,vtree,manager,{
+    SddLiteral first = 0; //first left sum of current group
+    for(SddLiteral s=0; s<l_count; s++) {
+      //sub interval of left sum s (as indices of right sums)
+      SddLiteral ri = first_sum(lo-l_sums[s],r_sums,r_count);
+      SddLiteral rj = last_sum(hi-l_sums[s],r_sums,r_count);
+      if(s+1<l_count) { //does the next left sum have the same sub interval?
+        SddLiteral ni = first_sum(lo-l_sums[s+1],r_sums,r_count);
+        SddLiteral nj = last_sum(hi-l_sums[s+1],r_sums,r_count);
+        if((ni==ri && nj==rj) || (ri>rj && ni>nj)) continue;
+      }
+      SddNode* prime = interval(vtree->left,l_sums[first],l_sums[s],linear,manager);
+      SddNode* sub   = ri>rj? manager->false_sdd: interval(vtree->right,r_sums[ri],r_sums[rj],linear,manager);
+      DECLARE_element(prime,sub,vtree,manager);
+      first = s+1;
+    }
+  });
+
+  IntervalComputed* c;
+  MALLOC(c,IntervalComputed,"interval");
+  c->vtree = vtree;
+  c->lo    = lo;
+  c->hi    = hi;
+  c->node  = node;
+  c->next  = linear->cache[key];
+  linear->cache[key] = c;
+  return node;
+}
+
+/****************************************************************************************
+ * parity
+ ****************************************************************************************/
+
+//returns an sdd for the parity of the variables in vtree being odd (NULL if vtree has no
+//variable with is_parity_var[var]==1)
+static
+SddNode* odd_parity(Vtree* vtree, int* is_parity_var, SddManager* manager) {
+  if(LEAF(vtree)) {
+    SddLiteral var = vtree->var;
+    return is_parity_var[var]? sdd_manager_literal(var,manager): NULL;
+  }
+  SddNode* left  = odd_parity(vtree->left,is_parity_var,manager);
+  SddNode* right = odd_parity(vtree->right,is_parity_var,manager);
+  if(left==NULL) return right;
+  if(right==NULL) return left;
+
+  SddNode* not_left  = sdd_negate(left,manager);
+  SddNode* not_right = sdd_negate(right,manager);
+
+  SddNode* node;
+  //elements are compressed (distinct subs) and primes are not trivial
+  GET_node_from_compressed_partition(node,vtree,manager,{
+    DECLARE_compressed_element(left,not_right,vtree,manager);
+    DECLARE_compressed_element(not_left,right,vtree,manager);
+  });
+  return node;
+}
+
+//vars is an array of size count
+//returns an sdd for the exclusive-or of vars (odd parity), its negation is even parity
+SddNode* sdd_parity(SddLiteral count, SddLiteral* vars, SddManager* manager) {
+  int* is_parity_var;
+  CALLOC(is_parity_var,int,1+manager->var_count,"sdd_parity");
+  for(SddLiteral i=0; i<count; i++) {
+    CHECK_ERROR(vars[i]<1 || vars[i]>manager->var_count,"\nerror in %s: invalid variable\n","sdd_parity");
+    is_parity_var[vars[i]] ^= 1; //x xor x is false
+  }
+
+  SddNode* node;
+  WITH_no_auto_mode(manager,{
+    node = odd_parity(manager->vtree,is_parity_var,manager);
+  });
+
+  free(is_parity_var);
+  return node==NULL? manager->false_sdd: node;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
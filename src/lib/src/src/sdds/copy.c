@@ -6,6 +6,10 @@
 
 #include "sdd.h"
 
+//sdds/apply.c
+SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, int limited);
+SddNode* sdd_conjoin_lr(SddNode* node1, SddNode* node2, Vtree* lca, SddManager* manager);
+
 //local declarations
 static void sdd_copy_aux(SddNode* node, SddNode** start, SddNode*** node_copies_loc, Vtree* org_vtree, Vtree* dest_vtree, SddManager* dest_manager);
 
@@ -112,6 +116,127 @@ void sdd_copy_aux(SddNode* node, SddNode** start, SddNode*** node_copies_loc, Vt
   
 }
 
+/****************************************************************************************
+ * transfer sdds from one manager to another, whose vtrees may differ
+ *
+ * nodes are transferred bottom-up, each node once (node->map holds its transfer)
+ *
+ * a node whose transferred primes are in the left subtree, and transferred subs in the
+ * right subtree, of the lca of their vtrees in the destination is constructed directly:
+ * its elements still form a compressed and trimmed partition for the lca. otherwise, 
+ * the node is the disjunction of its elements, each being a conjunction of a prime and
+ * a sub: conjunctions of incomparable nodes (e.g., literals of different variables) are
+ * constructed directly and only the remaining ones use apply
+ *
+ * variables keep their indices, so the destination must have the variables of the nodes
+ *
+ * will not do auto gc/minmize as its computations are done in no-auto mode
+ ****************************************************************************************/
+
+//the lca in the destination, if the transferred elements of node are a partition for it
+static
+Vtree* transferred_partition_vtree(SddNode* node, SddManager* dest_manager) {
+  Vtree* root  = dest_manager->vtree;
+  Vtree* lca   = NULL;
+  FOR_each_prime_sub_of_node(prime,sub,node,{
+    lca = lca==NULL? prime->map->vtree: sdd_vtree_lca(lca,prime->map->vtree,root);
+    if(NON_TRIVIAL(sub->map)) lca = sdd_vtree_lca(lca,sub->map->vtree,root);
+  });
+  if(LEAF(lca)) return NULL;
+  FOR_each_prime_sub_of_node(prime,sub,node,{
+    if(!sdd_vtree_is_sub(prime->map->vtree,lca->left)) return NULL;
+    if(NON_TRIVIAL(sub->map) && !sdd_vtree_is_sub(sub->map->vtree,lca->right)) return NULL;
+  });
+  return lca;
+}
+
+//conjunction of prime and sub, transferred into dest_manager
+static
+SddNode* transferred_element(SddNode* prime, SddNode* sub, SddManager* dest_manager) {
+  if(!NON_TRIVIAL(prime) || !NON_TRIVIAL(sub) || 
+     sdd_vtree_is_sub(prime->vtree,sub->vtree) || sdd_vtree_is_sub(sub->vtree,prime->vtree)) {
+    return apply(prime,sub,CONJOIN,dest_manager,0);
+  }
+  //incomparable vtrees: no apply is needed
+  if(prime->vtree->position > sub->vtree->position) SWAP(SddNode*,prime,sub);
+  Vtree* lca = sdd_vtree_lca(prime->vtree,sub->vtree,dest_manager->vtree);
+  return sdd_conjoin_lr(prime,sub,lca,dest_manager);
+}
+
+//sets node->map to the transfer of node
+static
+void transfer(SddNode* node, SddManager* dest_manager) {
+  if(node->bit==0) return; //already transferred
+  node->bit = 0;
+
+  SddNode* node_map;
+  if(node->type==FALSE) node_map = dest_manager->false_sdd;
+  else if(node->type==TRUE) node_map = dest_manager->true_sdd;
+  else if(node->type==LITERAL) {
+    CHECK_ERROR(VAR_OF(node)>dest_manager->var_count,"\nerror in %s: variable is not in destination manager\n","sdd_transfer");
+    node_map = sdd_manager_literal(LITERAL_OF(node),dest_manager);
+  }
+  else { //decomposition
+    FOR_each_prime_sub_of_node(prime,sub,node,{
+      transfer(prime,dest_manager);
+      transfer(sub,dest_manager);
+    });
+    Vtree* vtree = transferred_partition_vtree(node,dest_manager);
+    if(vtree) {
+      //NOTE: no compression is possible here (i.e., apply will not be called)
+      GET_node_from_compressed_partition(node_map,vtree,dest_manager,{
+        FOR_each_prime_sub_of_node(prime,sub,node,{
+          DECLARE_compressed_element(prime->map,sub->map,vtree,dest_manager);
+        });
+      });
+    }
+    else {
+      node_map = dest_manager->false_sdd;
+      FOR_each_prime_sub_of_node(prime,sub,node,{
+        SddNode* element = transferred_element(prime->map,sub->map,dest_manager);
+        node_map = apply(node_map,element,DISJOIN,dest_manager,0);
+      });
+    }
+  }
+  node->map = node_map;
+}
+
+//this function will leave all bits of nodes set to 1
+static
+void initialize_transfer(SddNode* node) {
+  if(node->bit) return;
+  node->bit = 1;
+  node->map = NULL;
+  if(node->type==DECOMPOSITION) {
+    FOR_each_prime_sub_of_node(prime,sub,node,{
+      initialize_transfer(prime);
+      initialize_transfer(sub);
+    });
+  }
+}
+
+//nodes and transfers are arrays of size count: transfers[i] is set to the sdd of
+//dest_manager equivalent to nodes[i] (nodes share transferred descendants)
+void sdd_transfer_multiple(SddSize count, SddNode** nodes, SddNode** transfers, SddManager* dest_manager) {
+  for(SddSize i=0; i<count; i++) {
+    CHECK_ERROR(GC_NODE(nodes[i]),ERR_MSG_GC,"sdd_transfer_multiple");
+    initialize_transfer(nodes[i]); //leaves bits 1
+  }
+  WITH_no_auto_mode(dest_manager,{
+    for(SddSize i=0; i<count; i++) {
+      transfer(nodes[i],dest_manager); //leaves bits 0
+      transfers[i] = nodes[i]->map;
+    }
+  });
+}
+
+//node is in some manager, whose vtree may be different from that of dest_manager
+SddNode* sdd_transfer(SddNode* node, SddManager* dest_manager) {
+  SddNode* transfer;
+  sdd_transfer_multiple(1,&node,&transfer,dest_manager);
+  return transfer;
+}
+
 /****************************************************************************************
  * end
  ****************************************************************************************/
@@ -300,7 +300,8 @@ SddNode* quantify_shadow(NodeShadow* shadow, int* exists_map, SddManager* manage
   //the cache_id field will be used to decide whether thet cached node was gc'd
   shadow->cache_id = q_node->id;
   assert(ref_count>=0);
-  for(SddRefCount i=0; i<shadow->ref_count-1; i++) { ++ref_count; sdd_ref(q_node,manager); }
+  SddRefCount shadow_ref_count = shadow->ref_count; //bit-field promotes to int
+  for(SddRefCount i=1; i<shadow_ref_count; i++) { ++ref_count; sdd_ref(q_node,manager); }
       
   return shadow->cache = q_node;
 }
@@ -0,0 +1,88 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//sdds/exists_multiple.c
+SddNode* sdd_exists_multiple(int* exists_map, SddNode* node, SddManager* manager);
+
+/****************************************************************************************
+ * universal quantification of a number of variables, and quantifier prefixes
+ *
+ *   forall X f = not exists X not f
+ *
+ * negations are kept with their nodes (node->negation), so the negations on both sides
+ * of sdd_exists_multiple are computed once per node
+ *
+ * a quantifier prefix is evaluated innermost block first: adjacent blocks with the same
+ * quantifier are merged, and each merged block is quantified by sdd_exists_multiple or
+ * sdd_forall_multiple
+ *
+ * will not do auto gc/minimize as its computations are done in no-auto mode
+ ****************************************************************************************/
+
+//forall_map is an array with the following properties:
+//size             : 1+number of variables in manager
+//forall_map[var]  : is 1 if var is to be universally quantified, 0 otherwise
+//forall_map[0]    : not used
+
+SddNode* sdd_forall_multiple(int* forall_map, SddNode* node, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(node),ERR_MSG_GC,"sdd_forall_multiple");
+
+  if(node->type==FALSE || node->type==TRUE) return node;
+
+  SddNode* q_node;
+  WITH_no_auto_mode(manager,{
+    q_node = sdd_negate(sdd_exists_multiple(forall_map,sdd_negate(node,manager),manager),manager);
+  });
+  return q_node;
+}
+
+//a quantifier prefix Q1 X1 ... Qn Xn (block 1 is outermost):
+//quantifiers      : array of size block_count, quantifiers[i] is 'e' (exists) or 'a' (forall)
+//                   for block i+1
+//var_blocks       : array of size 1+number of variables in manager
+//var_blocks[var]  : block of var (1..block_count), or 0 if var is free
+//var_blocks[0]    : not used
+
+SddNode* sdd_quantify_prefix(SddSize block_count, const char* quantifiers, SddSize* var_blocks, SddNode* node, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(node),ERR_MSG_GC,"sdd_quantify_prefix");
+  for(SddSize i=0; i<block_count; i++) {
+    CHECK_ERROR(quantifiers[i]!='e' && quantifiers[i]!='a',"\nerror in %s: quantifiers must be 'e' or 'a'\n","sdd_quantify_prefix");
+  }
+  for(SddLiteral var=1; var<=manager->var_count; var++) {
+    CHECK_ERROR(var_blocks[var]>block_count,"\nerror in %s: invalid block\n","sdd_quantify_prefix");
+  }
+
+  int* q_map;
+  CALLOC(q_map,int,1+manager->var_count,"sdd_quantify_prefix");
+
+  WITH_no_auto_mode(manager,{
+    SddSize last = block_count; //innermost block not yet quantified
+    while(last>0 && !TRIVIAL(node)) {
+      //merge blocks first..last with the same quantifier
+      SddSize first = last;
+      while(first>1 && quantifiers[first-2]==quantifiers[last-1]) --first;
+      int q_vars = 0;
+      for(SddLiteral var=1; var<=manager->var_count; var++) {
+        q_map[var] = first<=var_blocks[var] && var_blocks[var]<=last;
+        q_vars     = q_vars || q_map[var];
+      }
+      if(q_vars) {
+        if(quantifiers[last-1]=='a') node = sdd_forall_multiple(q_map,node,manager);
+        else node = sdd_exists_multiple(q_map,node,manager);
+      }
+      last = first-1;
+    }
+  });
+
+  free(q_map);
+  return node;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,306 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+#include "sdd/sdd.h" //ReachStats
+
+//manager/interface.c
+int sdd_manager_garbage_collect_if(float dead_node_threshold, SddManager* manager);
+
+//sdds/exists_multiple.c
+SddNode* sdd_exists_multiple(int* exists_map, SddNode* node, SddManager* manager);
+
+/****************************************************************************************
+ * reachability
+ *
+ * a transition system is given by pairs of current and next variables (which should be
+ * interleaved in the vtree, so renaming between them preserves the structure of sdds)
+ * and a transition relation, given as a conjunction of partitions over current, next
+ * and possibly other (unquantified) variables
+ *
+ * image(S)    = exists current: S and T1 and ... and Tk, renamed from next to current
+ * preimage(S) = exists next: S (renamed from current to next) and T1 and ... and Tk
+ *
+ * both are computed as a chain of relational products (sdd_and_exists), quantifying a
+ * variable as soon as no later partition mentions it (early quantification)
+ *
+ * reachable states are computed by a fixpoint over a frontier: the frontier of the next
+ * iteration is any set between the new states and all reached states, so the smaller of
+ * the two is used (frontier simplification)
+ *
+ * between iterations, intermediate results are released and a gc is performed when dead
+ * nodes exceed REACH_GC_THRESHOLD: only nodes referenced by the user survive it
+ ****************************************************************************************/
+
+//builds the quantification schedule: maps[i] contains the variables (with quantify[var]==1)
+//whose last occurrence is in partitions[i]; variables not in any partition go to maps[0]
+static
+int** quantification_schedule(int* quantify, SddSize count, SddNode** partitions, SddManager* manager) {
+  SddLiteral var_count = manager->var_count;
+  SddSize* last;
+  CALLOC(last,SddSize,1+var_count,"quantification_schedule");
+  for(SddSize i=0; i<count; i++) {
+    int* vars = sdd_variables(partitions[i],manager);
+    for(SddLiteral var=1; var<=var_count; var++) if(vars[var]) last[var] = i;
+    free(vars);
+  }
+  int** maps;
+  CALLOC(maps,int*,count,"quantification_schedule");
+  for(SddSize i=0; i<count; i++) CALLOC(maps[i],int,1+var_count,"quantification_schedule");
+  if(count) for(SddLiteral var=1; var<=var_count; var++) if(quantify[var]) maps[last[var]][var] = 1;
+  free(last);
+  return maps;
+}
+
+//(re)builds the rename map and the quantification schedules for the current variables of
+//the sdd manager (variables added after reach_manager_new are not paired)
+static
+void build_maps(ReachManager* reach_manager) {
+  SddManager* manager  = reach_manager->sdd_manager;
+  SddLiteral var_count = manager->var_count;
+  SddSize count        = reach_manager->partition_count;
+
+  if(reach_manager->rename_map) { //rebuilding
+    free(reach_manager->rename_map);
+    for(SddSize i=0; i<count; i++) {
+      free(reach_manager->image_maps[i]);
+      free(reach_manager->preimage_maps[i]);
+    }
+    free(reach_manager->image_maps);
+    free(reach_manager->preimage_maps);
+  }
+
+  int* is_current;
+  int* is_next;
+  CALLOC(is_current,int,1+var_count,"build_maps");
+  CALLOC(is_next,int,1+var_count,"build_maps");
+  CALLOC(reach_manager->rename_map,SddLiteral,1+var_count,"build_maps");
+  for(SddLiteral var=1; var<=var_count; var++) reach_manager->rename_map[var] = var;
+  for(SddLiteral i=0; i<reach_manager->pair_count; i++) {
+    SddLiteral c = reach_manager->current_vars[i];
+    SddLiteral n = reach_manager->next_vars[i];
+    is_current[c] = is_next[n] = 1;
+    reach_manager->rename_map[c] = n;
+    reach_manager->rename_map[n] = c;
+  }
+  reach_manager->image_maps    = quantification_schedule(is_current,count,reach_manager->partitions,manager);
+  reach_manager->preimage_maps = quantification_schedule(is_next,count,reach_manager->partitions,manager);
+  reach_manager->var_count     = var_count;
+
+  free(is_current);
+  free(is_next);
+}
+
+//maps are sized by the variable count of the sdd manager when they were built
+static
+void update_maps(ReachManager* reach_manager) {
+  SddLiteral var_count = reach_manager->sdd_manager->var_count;
+  CHECK_ERROR(var_count < reach_manager->var_count,"\nerror in %s: variables were removed from the manager\n","reach_manager");
+  if(var_count > reach_manager->var_count) build_maps(reach_manager); //variables were added
+}
+
+//current_vars and next_vars are arrays of size pair_count (the arrays are copied)
+//partitions is an array of size partition_count (the array is copied and its sdds referenced)
+ReachManager* reach_manager_new(SddLiteral pair_count, SddLiteral* current_vars, SddLiteral* next_vars, SddSize partition_count, SddNode** partitions, SddManager* manager) {
+  SddLiteral var_count = manager->var_count;
+  ReachManager* reach_manager;
+  MALLOC(reach_manager,ReachManager,"reach_manager_new");
+
+  reach_manager->sdd_manager     = manager;
+  reach_manager->pair_count      = pair_count;
+  reach_manager->rename_map      = NULL;
+  reach_manager->iteration_count = 0;
+  reach_manager->stats_capacity  = 0;
+  reach_manager->stats           = NULL;
+
+  int* paired;
+  CALLOC(paired,int,1+var_count,"reach_manager_new");
+  CALLOC(reach_manager->current_vars,SddLiteral,pair_count,"reach_manager_new");
+  CALLOC(reach_manager->next_vars,SddLiteral,pair_count,"reach_manager_new");
+  for(SddLiteral i=0; i<pair_count; i++) {
+    SddLiteral c = current_vars[i];
+    SddLiteral n = next_vars[i];
+    CHECK_ERROR(c<1 || c>var_count || n<1 || n>var_count,"\nerror in %s: invalid variable\n","reach_manager_new");
+    CHECK_ERROR(c==n || paired[c] || paired[n],"\nerror in %s: variables must be paired once\n","reach_manager_new");
+    paired[c] = paired[n] = 1;
+    reach_manager->current_vars[i] = c;
+    reach_manager->next_vars[i]    = n;
+  }
+  free(paired);
+
+  reach_manager->partition_count = partition_count;
+  CALLOC(reach_manager->partitions,SddNode*,partition_count,"reach_manager_new");
+  for(SddSize i=0; i<partition_count; i++) {
+    CHECK_ERROR(GC_NODE(partitions[i]),ERR_MSG_GC,"reach_manager_new");
+    reach_manager->partitions[i] = sdd_ref(partitions[i],manager);
+  }
+  register_nodes(reach_manager->partitions,partition_count,manager); //see sdd_manager_compact
+  build_maps(reach_manager);
+
+  return reach_manager;
+}
+
+void reach_manager_free(ReachManager* reach_manager) {
+  SddManager* manager = reach_manager->sdd_manager;
+  for(SddSize i=0; i<reach_manager->partition_count; i++) {
+    sdd_deref(reach_manager->partitions[i],manager);
+    free(reach_manager->image_maps[i]);
+    free(reach_manager->preimage_maps[i]);
+  }
+  unregister_nodes(reach_manager->partitions,manager);
+  free(reach_manager->partitions);
+  free(reach_manager->image_maps);
+  free(reach_manager->preimage_maps);
+  free(reach_manager->rename_map);
+  free(reach_manager->current_vars);
+  free(reach_manager->next_vars);
+  free(reach_manager->stats);
+  free(reach_manager);
+}
+
+SddSize reach_iteration_count(ReachManager* reach_manager) {
+  return reach_manager->iteration_count;
+}
+
+//statistics of the iterations of the last reach_forward or reach_backward
+ReachStats* reach_stats(ReachManager* reach_manager) {
+  return reach_manager->stats;
+}
+
+/****************************************************************************************
+ * image and preimage
+ ****************************************************************************************/
+
+//conjoins node with all partitions, quantifying variables according to maps
+//(quantify is used when there are no partitions)
+static
+SddNode* relational_product(SddNode* node, int** maps, int* quantify, ReachManager* reach_manager) {
+  SddManager* manager = reach_manager->sdd_manager;
+  if(reach_manager->partition_count==0) return sdd_exists_multiple(quantify,node,manager);
+
+  sdd_ref(node,manager);
+  for(SddSize i=0; i<reach_manager->partition_count; i++) {
+    SddNode* product = sdd_and_exists(node,reach_manager->partitions[i],maps[i],manager);
+    sdd_ref(product,manager);
+    sdd_deref(node,manager);
+    node = product;
+  }
+  sdd_deref(node,manager);
+  return node;
+}
+
+//quantification map of all paired variables: with no partitions, the relation is true
+//and the product involves only current (image) or only next (preimage) variables
+static
+int* paired_vars_map(ReachManager* reach_manager) {
+  SddManager* manager = reach_manager->sdd_manager;
+  int* map;
+  CALLOC(map,int,1+manager->var_count,"paired_vars_map");
+  for(SddLiteral var=1; var<=manager->var_count; var++) {
+    map[var] = reach_manager->rename_map[var]!=var;
+  }
+  return map;
+}
+
+//states are over current variables: returns their successors (over current variables)
+SddNode* reach_image(SddNode* states, ReachManager* reach_manager) {
+  CHECK_ERROR(GC_NODE(states),ERR_MSG_GC,"reach_image");
+  update_maps(reach_manager);
+  SddManager* manager = reach_manager->sdd_manager;
+  int* quantify = reach_manager->partition_count? NULL: paired_vars_map(reach_manager);
+  SddNode* next = relational_product(states,reach_manager->image_maps,quantify,reach_manager);
+  free(quantify);
+  return sdd_rename_variables(next,reach_manager->rename_map,manager);
+}
+
+//states are over current variables: returns their predecessors (over current variables)
+SddNode* reach_preimage(SddNode* states, ReachManager* reach_manager) {
+  CHECK_ERROR(GC_NODE(states),ERR_MSG_GC,"reach_preimage");
+  update_maps(reach_manager);
+  SddManager* manager = reach_manager->sdd_manager;
+  int* quantify = reach_manager->partition_count? NULL: paired_vars_map(reach_manager);
+  SddNode* next = sdd_rename_variables(states,reach_manager->rename_map,manager);
+  SddNode* node = relational_product(next,reach_manager->preimage_maps,quantify,reach_manager);
+  free(quantify);
+  return node;
+}
+
+/****************************************************************************************
+ * fixpoints
+ ****************************************************************************************/
+
+static
+void record_stats(SddSize iteration, SddNode* frontier, SddNode* image, SddNode* reached, clock_t start, ReachManager* reach_manager) {
+  if(iteration >= reach_manager->stats_capacity) {
+    reach_manager->stats_capacity = 2*reach_manager->stats_capacity+16;
+    REALLOC(reach_manager->stats,ReachStats,reach_manager->stats_capacity,"record_stats");
+  }
+  ReachStats* stats    = reach_manager->stats+iteration;
+  stats->frontier_size = sdd_size(frontier);
+  stats->image_size    = sdd_size(image);
+  stats->reached_size  = sdd_size(reached);
+  stats->live_count    = sdd_manager_live_count(reach_manager->sdd_manager);
+  stats->time          = (float)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+//least fixpoint of states, adding image(frontier) (or preimage) at each iteration
+static
+SddNode* reach_fixpoint(SddNode* states, int backward, ReachManager* reach_manager) {
+  SddManager* manager = reach_manager->sdd_manager;
+  SddNode* reached    = sdd_ref(states,manager);
+  SddNode* frontier   = sdd_ref(states,manager);
+  SddSize iteration   = 0;
+
+  while(!IS_FALSE(frontier)) {
+    clock_t start = clock();
+
+    SddNode* image = backward? reach_preimage(frontier,reach_manager): reach_image(frontier,reach_manager);
+    sdd_ref(image,manager);
+    SddNode* new_states = sdd_apply(image,sdd_negate(reached,manager),CONJOIN,manager);
+    sdd_ref(new_states,manager);
+    SddNode* new_reached = sdd_apply(reached,new_states,DISJOIN,manager);
+    sdd_ref(new_reached,manager);
+
+    //frontier simplification: new_states <= frontier <= new_reached
+    SddNode* new_frontier = new_states;
+    if(!IS_FALSE(new_states) && sdd_size(new_reached) < sdd_size(new_states)) new_frontier = new_reached;
+    sdd_ref(new_frontier,manager);
+
+    record_stats(iteration++,frontier,image,new_reached,start,reach_manager);
+
+    sdd_deref(frontier,manager);
+    sdd_deref(reached,manager);
+    sdd_deref(image,manager);
+    sdd_deref(new_states,manager);
+    frontier = new_frontier;
+    reached  = new_reached;
+
+    sdd_manager_garbage_collect_if(REACH_GC_THRESHOLD,manager);
+    //sizes above were taken before gc, live count is updated after it
+    reach_manager->stats[iteration-1].live_count = sdd_manager_live_count(manager);
+  }
+
+  reach_manager->iteration_count = iteration;
+  sdd_deref(frontier,manager);
+  sdd_deref(reached,manager);
+  return reached;
+}
+
+//init is over current variables: returns states reachable from init
+SddNode* reach_forward(SddNode* init, ReachManager* reach_manager) {
+  CHECK_ERROR(GC_NODE(init),ERR_MSG_GC,"reach_forward");
+  return reach_fixpoint(init,0,reach_manager);
+}
+
+//target is over current variables: returns states from which target is reachable
+SddNode* reach_backward(SddNode* target, ReachManager* reach_manager) {
+  CHECK_ERROR(GC_NODE(target),ERR_MSG_GC,"reach_backward");
+  return reach_fixpoint(target,1,reach_manager);
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -9,11 +9,16 @@
 //local declarations
 void sdd_rename_variables_aux(SddNode* node, SddLiteral* variable_map, SddManager* manager);
 static void initialize_map(SddNode* node, SddLiteral* variable_map);
+static Vtree** structure_preserving_map(SddNode* node, SddLiteral* variable_map, SddManager* manager);
+static void relabel(SddNode* node, SddLiteral* variable_map, Vtree** vtree_map, SddManager* manager);
 
 /****************************************************************************************
  * given an sdd, and a variable map,
  * construct a new sdd by mapping the variables of the original sdd into new ones
  *
+ * if the renaming preserves the structure of the sdd (see below), its nodes are relabeled
+ * directly; otherwise, the sdd is reconstructed using apply
+ *
  * will not do auto gc/minmize as its computations are done in no-auto mode
  ****************************************************************************************/
 
@@ -30,11 +35,16 @@ SddNode* sdd_rename_variables(SddNode* node, SddLiteral* variable_map, SddManage
   if(node->type==FALSE || node->type==TRUE) return node;
   //node is not trivial
 
+  Vtree** vtree_map = structure_preserving_map(node,variable_map,manager);
+
   WITH_no_auto_mode(manager,{
     initialize_map(node,variable_map);
-    sdd_rename_variables_aux(node,variable_map,manager);
+    if(vtree_map) relabel(node,variable_map,vtree_map,manager);
+    else sdd_rename_variables_aux(node,variable_map,manager);
   });
   
+  free(vtree_map);
+  
   return node->map;
 }
 
@@ -70,6 +80,105 @@ void sdd_rename_variables_aux(SddNode* node, SddLiteral* variable_map, SddManage
   
 }
 
+/****************************************************************************************
+ * structure preserving renaming
+ *
+ * let the vtree map m send the leaf of each variable used by the sdd to the leaf of its
+ * renamed variable, and an internal vtree node v (with used variables on both sides) to
+ * the lca of m(v->left) and m(v->right)
+ *
+ * the renaming preserves the structure of the sdd if it is injective on the used 
+ * variables and, for every such v, m(v->left) is in the left subtree of m(v) and 
+ * m(v->right) in its right subtree (e.g., swapping the variables of isomorphic subtrees
+ * or of interleaved current/next pairs)
+ *
+ * a node normalized for v is then renamed into the node normalized for m(v) whose
+ * elements are the renamed elements: they still form a compressed and trimmed partition,
+ * so it is constructed directly, with no apply
+ ****************************************************************************************/
+
+//returns m(vtree), or NULL if vtree has no used variables; clears *ok on failure
+static
+Vtree* map_vtree(Vtree* vtree, int* used, SddLiteral* variable_map, Vtree** vtree_map, int* ok, SddManager* manager) {
+  if(LEAF(vtree)) {
+    SddLiteral var = vtree->var;
+    return used[var]? sdd_manager_vtree_of_var(variable_map[var],manager): NULL;
+  }
+  Vtree* left  = map_vtree(vtree->left,used,variable_map,vtree_map,ok,manager);
+  Vtree* right = map_vtree(vtree->right,used,variable_map,vtree_map,ok,manager);
+  if(*ok==0) return NULL;
+  if(left==NULL) return right;
+  if(right==NULL) return left;
+  Vtree* lca = sdd_vtree_lca(left,right,manager->vtree);
+  if(LEAF(lca) || !sdd_vtree_is_sub(left,lca->left) || !sdd_vtree_is_sub(right,lca->right)) {
+    *ok = 0;
+    return NULL;
+  }
+  vtree_map[vtree->position] = lca;
+  return lca;
+}
+
+//returns the vtree map indexed by vtree positions if the renaming preserves the 
+//structure of node, NULL otherwise
+static
+Vtree** structure_preserving_map(SddNode* node, SddLiteral* variable_map, SddManager* manager) {
+  if(node->type!=DECOMPOSITION) return NULL;
+
+  SddLiteral var_count = manager->var_count;
+  int* used = sdd_variables(node,manager);
+  int* hit;
+  CALLOC(hit,int,1+var_count,"structure_preserving_map");
+  int ok = 1;
+  for(SddLiteral var=1; var<=var_count && ok; var++) {
+    if(used[var]==0) continue;
+    SddLiteral new_var = variable_map[var];
+    ok = hit[new_var]==0; //injective
+    hit[new_var] = 1;
+  }
+  free(hit);
+
+  Vtree** vtree_map = NULL;
+  if(ok) {
+    CALLOC(vtree_map,Vtree*,1+manager->vtree->last->position,"structure_preserving_map");
+    map_vtree(node->vtree,used,variable_map,vtree_map,&ok,manager);
+    if(ok==0) {
+      free(vtree_map);
+      vtree_map = NULL;
+    }
+  }
+  free(used);
+  return vtree_map;
+}
+
+//computes node maps by relabeling and stores them in the map field
+static
+void relabel(SddNode* node, SddLiteral* variable_map, Vtree** vtree_map, SddManager* manager) {
+  if(node->map!=NULL) return;
+
+  SddNode* node_map;
+
+  if(node->type==LITERAL) {
+    SddLiteral new_var = variable_map[VAR_OF(node)];
+    node_map = sdd_manager_literal(LITERAL_OF(node)>0? new_var: -new_var,manager);
+  }
+  else { //decomposition
+    FOR_each_prime_sub_of_node(prime,sub,node,{
+      relabel(prime,variable_map,vtree_map,manager);
+      relabel(sub,variable_map,vtree_map,manager);
+    });
+    Vtree* vtree = vtree_map[node->vtree->position];
+    assert(vtree!=NULL);
+    //NOTE: no compression is possible here (i.e., apply will not be called)
+    GET_node_from_compressed_partition(node_map,vtree,manager,{
+      FOR_each_prime_sub_of_node(prime,sub,node,{
+        DECLARE_compressed_element(prime->map,sub->map,vtree,manager);
+      });
+    });
+  }
+
+  node->map = node_map;
+}
+
 /****************************************************************************************
  * initialized the mapped field of nodes:
  *
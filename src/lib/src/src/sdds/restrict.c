@@ -0,0 +1,220 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//sdds/apply.c
+SddNode* apply(SddNode* node1, SddNode* node2, BoolOp op, SddManager* manager, int limited);
+SddElement* partition_for_vtree(SddNode* node, Vtree* vtree, SddElement* elements, SddNodeSize* size, SddManager* manager);
+
+/****************************************************************************************
+ * simplifying an sdd f using a care set c: any f' with (f' and c) = (f and c) is correct
+ *
+ * both operations below recurse over f and c normalized for the lca of their vtrees,
+ * with (pi,si) and (ck,dk) the elements of f and c for that vtree (see ite in apply.c)
+ *
+ * restrict:
+ * --if f is normalized below the lca, only the projection of c on the side of f matters
+ * --otherwise, the care set of si is the disjunction of the dk with (pi and ck) consistent;
+ *   elements with an empty care set are don't cares and their primes are merged into
+ *   another element. a sub that agrees with the (simplified) sub of an earlier element
+ *   on its care set is replaced by it, so the two elements merge (compression)
+ * --the result only mentions variables of f, and is never larger than f
+ *
+ * constrain:
+ * --the result is constructed from the product of the partitions of f and c: the sub of
+ *   (pi and ck) is si constrained by dk. regions where c is false (dk false) are don't
+ *   cares and take the sub of the first region where c is not false, so they merge
+ * --the result may mention variables of c, and is usually smaller when c is local
+ *
+ * results depend only on f and c, so they are cached in the restrict cache of the manager
+ * (see computed.c) across calls, keyed by f and by c and the operation
+ *
+ * will not do auto gc/minimize as its computations are done in no-auto mode
+ ****************************************************************************************/
+
+//local declarations
+static SddNode* restrict_aux(SddNode* node, SddNode* care, SddManager* manager);
+static SddNode* constrain_aux(SddNode* node, SddNode* care, SddManager* manager);
+
+SddNode* sdd_restrict(SddNode* node, SddNode* care, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(node),ERR_MSG_GC,"sdd_restrict");
+  CHECK_ERROR(GC_NODE(care),ERR_MSG_GC,"sdd_restrict");
+
+  SddNode* result;
+  WITH_no_auto_mode(manager,{
+    result = restrict_aux(node,care,manager);
+  });
+
+  return sdd_size(result) <= sdd_size(node)? result: node;
+}
+
+SddNode* sdd_constrain(SddNode* node, SddNode* care, SddManager* manager) {
+  CHECK_ERROR(GC_NODE(node),ERR_MSG_GC,"sdd_constrain");
+  CHECK_ERROR(GC_NODE(care),ERR_MSG_GC,"sdd_constrain");
+
+  SddNode* result;
+  WITH_no_auto_mode(manager,{
+    result = constrain_aux(node,care,manager);
+  });
+
+  return result;
+}
+
+//second key of the restrict cache: care and the operation
+static inline
+SddSize care_key(SddNode* care, int constrain) {
+  return 2*care->id+constrain;
+}
+
+//returns the result for trivial cases, NULL otherwise
+static inline
+SddNode* simplify_base(SddNode* node, SddNode* care, SddManager* manager) {
+  if(IS_FALSE(care)) return manager->false_sdd; //everything is a don't care
+  if(IS_TRUE(care) || !NON_TRIVIAL(node)) return node;
+  if(node==care) return manager->true_sdd;
+  if(node==care->negation) return manager->false_sdd;
+  return NULL;
+}
+
+/****************************************************************************************
+ * restrict
+ ****************************************************************************************/
+
+//the projection of care on the sub_vtree of vtree that contains sub_vtree (left or right)
+//care is normalized for vtree
+static
+SddNode* project(SddNode* care, Vtree* vtree, Vtree* sub_vtree, SddManager* manager) {
+  assert(care->vtree==vtree);
+  int left = sdd_vtree_is_sub(sub_vtree,vtree->left);
+  SddNode* projection = manager->false_sdd;
+  FOR_each_prime_sub_of_node(prime,sub,care,{
+    if(IS_FALSE(sub)) continue;
+    projection = apply(projection,left? prime: sub,DISJOIN,manager,0);
+  });
+  return projection;
+}
+
+static
+SddNode* restrict_aux(SddNode* node, SddNode* care, SddManager* manager) {
+  SddNode* result = simplify_base(node,care,manager);
+  if(result!=NULL) return result;
+
+  result = lookup_op_computation(node->id,care_key(care,0),&manager->restrict_cache,manager);
+  if(result!=NULL) return result; //cache hit
+
+  Vtree* vtree = sdd_vtree_lca(node->vtree,care->vtree,manager->vtree);
+  if(node->vtree!=vtree) { //node is in one side of vtree
+    if(care->vtree!=vtree) result = node; //node and care are independent
+    else result = restrict_aux(node,project(care,vtree,node->vtree,manager),manager);
+  }
+  else {
+    SddElement storage[2];
+    SddNodeSize care_size;
+    SddElement* care_elements = partition_for_vtree(care,vtree,storage,&care_size,manager);
+
+    SddNodeSize size = node->size;
+    SddElement* elements = ELEMENTS_OF(node);
+    SddNode** cares;
+    SddNode** subs;
+    CALLOC(cares,SddNode*,size,"restrict_aux");
+    CALLOC(subs,SddNode*,size,"restrict_aux");
+
+    SddNode* dont_care = manager->false_sdd; //primes of elements with empty care sets
+    SddNodeSize first = size; //first element with a non-empty care set
+    for(SddNodeSize i=0; i<size; i++) {
+      SddNode* prime = elements[i].prime;
+      SddNode* sub   = elements[i].sub;
+      cares[i] = manager->false_sdd;
+      for(SddElement* e=care_elements; e<care_elements+care_size; e++) {
+        if(IS_FALSE(e->sub) || IS_FALSE(apply(prime,e->prime,CONJOIN,manager,0))) continue;
+        cares[i] = apply(cares[i],e->sub,DISJOIN,manager,0);
+      }
+      if(IS_FALSE(cares[i])) {
+        dont_care = apply(dont_care,prime,DISJOIN,manager,0);
+        continue;
+      }
+      if(first==size) first = i;
+      subs[i] = restrict_aux(sub,cares[i],manager);
+      //merge with an earlier sub that agrees with sub on its care set
+      SddNode* care_sub = apply(sub,cares[i],CONJOIN,manager,0);
+      for(SddNodeSize j=0; j<i; j++) {
+        if(subs[j]==NULL || subs[j]==subs[i]) continue;
+        if(apply(subs[j],cares[i],CONJOIN,manager,0)==care_sub) {
+          subs[i] = subs[j];
+          break;
+        }
+      }
+    }
+    assert(first<size); //care is not false
+
+    //NOTE: compression is possible here (i.e., apply may be called)
+    GET_node_from_partition(result,vtree,manager,{
+      for(SddNodeSize i=0; i<size; i++) {
+        if(subs[i]==NULL) continue; //don't care
+        SddNode* prime = elements[i].prime;
+        if(i==first) prime = apply(prime,dont_care,DISJOIN,manager,0);
+        DECLARE_element(prime,subs[i],vtree,manager);
+      }
+    });
+
+    free(cares);
+    free(subs);
+  }
+  assert(result!=NULL);
+
+  cache_op_computation(node->id,care_key(care,0),result,&manager->restrict_cache,manager);
+  return result;
+}
+
+/****************************************************************************************
+ * constrain
+ ****************************************************************************************/
+
+static
+SddNode* constrain_aux(SddNode* node, SddNode* care, SddManager* manager) {
+  SddNode* result = simplify_base(node,care,manager);
+  if(result!=NULL) return result;
+
+  result = lookup_op_computation(node->id,care_key(care,1),&manager->restrict_cache,manager);
+  if(result!=NULL) return result; //cache hit
+
+  Vtree* vtree = sdd_vtree_lca(node->vtree,care->vtree,manager->vtree);
+  SddElement node_storage[2], care_storage[2];
+  SddNodeSize node_size, care_size;
+  SddElement* node_elements = partition_for_vtree(node,vtree,node_storage,&node_size,manager);
+  SddElement* care_elements = partition_for_vtree(care,vtree,care_storage,&care_size,manager);
+
+  //sub of the first region where care is not false (taken by don't care regions)
+  SddNode* dont_care_sub = NULL;
+  for(SddElement* n=node_elements; n<node_elements+node_size && dont_care_sub==NULL; n++) {
+    for(SddElement* c=care_elements; c<care_elements+care_size && dont_care_sub==NULL; c++) {
+      if(IS_FALSE(c->sub) || IS_FALSE(apply(n->prime,c->prime,CONJOIN,manager,0))) continue;
+      dont_care_sub = constrain_aux(n->sub,c->sub,manager);
+    }
+  }
+  assert(dont_care_sub!=NULL); //care is not false
+
+  //NOTE: compression is possible here (i.e., apply may be called)
+  GET_node_from_partition(result,vtree,manager,{
+    for(SddElement* n=node_elements; n<node_elements+node_size; n++) {
+      for(SddElement* c=care_elements; c<care_elements+care_size; c++) {
+        SddNode* prime = apply(n->prime,c->prime,CONJOIN,manager,0);
+        if(IS_FALSE(prime)) continue;
+        SddNode* sub = IS_FALSE(c->sub)? dont_care_sub: constrain_aux(n->sub,c->sub,manager);
+        DECLARE_element(prime,sub,vtree,manager);
+      }
+    }
+  });
+  assert(result!=NULL);
+
+  cache_op_computation(node->id,care_key(care,1),result,&manager->restrict_cache,manager);
+  return result;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
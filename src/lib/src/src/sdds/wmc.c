@@ -67,6 +67,7 @@ WmcManager* wmc_manager_new(SddNode* node, int lm, SddManager* manager) {
   wmc_manager->log_mode    = lm; //save mode
   wmc_manager->node        = node;
   wmc_manager->sdd_manager = manager;
+  ++manager->wmc_manager_count; //see sdd_manager_compact
   
   //nodes are sorted so children appear before parents in the array
   //n->index contains the location of node n in the array
@@ -104,6 +105,7 @@ WmcManager* wmc_manager_new(SddNode* node, int lm, SddManager* manager) {
 
 
 void wmc_manager_free(WmcManager* wmc_manager) {
+  --wmc_manager->sdd_manager->wmc_manager_count;
   free(wmc_manager->nodes);
   free(wmc_manager->node_indices);
   free(wmc_manager->node_wmcs);
@@ -7,7 +7,7 @@
 #include "sdd.h"
 
 //basic/memory.c
-SddElement* new_elements(SddNodeSize size, SddManager* manager);
+SddElement* new_vtree_elements(SddNodeSize size, Vtree* vtree, SddManager* manager);
 
 //basic/multiply.c
 int multiply_decompositions(SddElement* elements1, SddNodeSize size1, SddElement* elements2, SddNodeSize size2, 
@@ -89,7 +89,7 @@ int close_cartesian_product(int compress, SddNodeSize* size, SddElement** elemen
     COMPRESS_S3_to_S1(manager,limited); //compressed elements in stack1 now (may fail returning with 0)
   }
   *size     = STACK_SIZE(cp_stack1,manager);
-  *elements = new_elements(*size,manager);
+  *elements = new_vtree_elements(*size,vtree,manager);
   memcpy(*elements,STACK_START(cp_stack1,manager),*size*sizeof(SddElement));
   assert(*size > 1);
   return 1;
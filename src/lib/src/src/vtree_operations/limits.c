@@ -47,6 +47,15 @@ void end_search_limits(SddManager* manager) { //called upon finishing vtree sear
 int search_aborted(SddManager* manager) { //called to check whether vtree search has been aborted
   return manager->vtree_ops.search_aborted;
 }
+int exceeded_search_time_limit(SddManager* manager) { //called by searches outside vtree ops
+  if(manager->vtree_ops.search_aborted) return 1;
+  if(manager->vtree_ops.search_time_limit && manager->vtree_ops.search_time_stamp &&
+     clock() > manager->vtree_ops.search_time_limit+manager->vtree_ops.search_time_stamp) {
+    ++manager->auto_search_invocation_count_aborted_search;
+    return manager->vtree_ops.search_aborted = 1;
+  }
+  return 0;
+}
 
 //
 //limiting fragment search
@@ -18,7 +18,8 @@ static int try_rotating_partition_left(SddNodeSize* size, SddElement** elements,
 //
 //returns 1 if rotation is done within limits, otherwise returns 0
 //0 means no limit
-int sdd_vtree_rotate_left(Vtree* x, SddManager* manager, int limited) {
+static
+int vtree_rotate_left(Vtree* x, SddManager* manager, int limited) {
   
   if(limited) start_op_limits(manager);
   
@@ -91,6 +92,13 @@ int sdd_vtree_rotate_left(Vtree* x, SddManager* manager, int limited) {
   return success; 
 }
 
+//reference counts must be exact during the left rotation (see basic/references.c)
+int sdd_vtree_rotate_left(Vtree* x, SddManager* manager, int limited) {
+  int success;
+  WITH_immediate_refs(manager,success = vtree_rotate_left(x,manager,limited));
+  return success;
+}
+
 /****************************************************************************************
  * left-rotates the partition of an sdd node
  *
@@ -18,7 +18,8 @@ static int try_swapping_partition(SddNodeSize* size, SddElement** elements, SddN
 //
 //return 1 if swapping is done within limits, otherwise return 0
 //0 means no limit
-int sdd_vtree_swap(Vtree* v, SddManager* manager, int limited) {
+static
+int vtree_swap(Vtree* v, SddManager* manager, int limited) {
   
   if(limited) start_op_limits(manager);
    
@@ -80,6 +81,13 @@ int sdd_vtree_swap(Vtree* v, SddManager* manager, int limited) {
   return success;
 }
 
+//reference counts must be exact during the swap (see basic/references.c)
+int sdd_vtree_swap(Vtree* v, SddManager* manager, int limited) {
+  int success;
+  WITH_immediate_refs(manager,success = vtree_swap(v,manager,limited));
+  return success;
+}
+
 /****************************************************************************************
  * swaps the partition of an sdd node
  *
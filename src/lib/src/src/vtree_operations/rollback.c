@@ -12,8 +12,8 @@ void inc_element_parent_counts(SddSize size, SddElement* elements, SddManager* m
 void dec_element_parent_counts(SddSize size, SddElement* elements, SddManager* manager);
 
 //basic/replace.c
-void reverse_node_replacement(SddNode* node, Vtree* vtree, SddManager* manager);
-void confirm_node_replacement(SddNode* node, SddManager* manager);
+void commit_node_replacements(SddManager* manager);
+void rollback_node_replacements(Vtree* vtree, SddManager* manager);
     
 /****************************************************************************************
  * moves nodes to a new vtree
@@ -34,16 +34,13 @@ void move_to_vtree(SddNode* nodes, Vtree* vtree, SddManager* manager) {
  * confirm nodes replacement as rollback is not longer needed
  ****************************************************************************************/
 
-//free saved elements of replaced_nodes
+//commit the replacement journal (frees replaced elements)
 //insert replaced_nodes into unique table (nodes already normalized for vtree)
 //move moved_nodes to vtree
 //replaced_nodes and moved_nodes are a linked list
 void finalize_vtree_op(SddNode* replaced_nodes, SddNode* moved_nodes, Vtree* vtree, SddManager* manager) {  
-  FOR_each_linked_node(n,replaced_nodes,{
-    assert(n->replaced);
-    confirm_node_replacement(n,manager); //frees saved elements
-    insert_in_unique_table(n,manager);
-  });
+  commit_node_replacements(manager);
+  FOR_each_linked_node(n,replaced_nodes,insert_in_unique_table(n,manager));
   move_to_vtree(moved_nodes,vtree,manager);
 }
 
@@ -51,15 +48,13 @@ void finalize_vtree_op(SddNode* replaced_nodes, SddNode* moved_nodes, Vtree* vtr
  * undo node replacement due a rollback
  ****************************************************************************************/
  
-//reverse the replacement of replaced_nodes (if any)
+//roll back the replacement journal (not all replaced_nodes may have been replaced)
 //insert replaced_nodes back into unique table
 //move moved_nodes to vtree
 //replaced_nodes and moved_nodes are a linked list
 void rollback_vtree_op(SddNode* replaced_nodes, SddNode* moved_nodes, Vtree* vtree, SddManager* manager) {
-  FOR_each_linked_node(n,replaced_nodes,{
-    if(n->replaced) reverse_node_replacement(n,vtree,manager); //not all nodes may have been replaced
-    insert_in_unique_table(n,manager);
-  });
+  rollback_node_replacements(vtree,manager);
+  FOR_each_linked_node(n,replaced_nodes,insert_in_unique_table(n,manager));
   move_to_vtree(moved_nodes,vtree,manager);
 }
  
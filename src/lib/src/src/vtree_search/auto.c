@@ -13,6 +13,8 @@ int root_apply(SddManager* manager);
 static int try_auto_minimize_top(Vtree* vtree, SddManager* manager);
 static int try_auto_minimize_recursive(Vtree* vtree, SddManager* manager);
 static void save_size(Vtree* vtree);
+static Vtree* growth_focus(Vtree* vtree);
+static void adapt_growth(SddSize init_size, clock_t search_time, clock_t apply_time, SddManager* manager);
     
 /****************************************************************************************
  * invoking vtree search and/or gc in auto mode
@@ -23,6 +25,22 @@ static void save_size(Vtree* vtree);
  * deciding an auto trigger is all about identifying the right:
  * --FEATURES to consider in designing an auto test; and
  * --the corresponding THRESHOLDS for these features
+ *
+ * two policies are supported for searches after top-level applies (see
+ * sdd_manager_set_auto_search_policy):
+ *
+ * --'f': fixed growth thresholds (GLOBAL_GROWTH and LOCAL_GROWTH)
+ * --'g': growth thresholds that adapt to the cost and benefit of previous searches:
+ *        a search that achieves little reduction (MIN_REDUCTION), or that takes a large
+ *        share of the time (MAX_SEARCH_SHARE), raises the thresholds, while a cheap and
+ *        effective search lowers them. the share of time compares the time of searches
+ *        (top-level and recursive) to the time of top-level applies, excluding searches,
+ *        since the previous top-level search. the thresholds adapted are the global and
+ *        local growth, and the apply growth that gates recursive searches (which never
+ *        drops below RECURSIVE_GROWTH). no search is triggered on sdds smaller than
+ *        MIN_SEARCH_SIZE. a triggered search is focused on the subtree that accounts for
+ *        most of the growth (GROWTH_FOCUS) since the last search, and the baselines of
+ *        the whole vtree it was selected from are saved afterwards
  ****************************************************************************************/
 
 /****************************************************************************************
@@ -39,19 +57,64 @@ static void save_size(Vtree* vtree);
 //for triggering gc after any apply
 #define DEAD_APPLY_GROWTH .5
 
+//for the adaptive growth policy
+#define MIN_SEARCH_SIZE   512
+#define MIN_GLOBAL_GROWTH 1.25
+#define MAX_GLOBAL_GROWTH 8
+#define MIN_LOCAL_GROWTH  1.05
+#define MAX_LOCAL_GROWTH  2
+#define MIN_APPLY_GROWTH  RECURSIVE_GROWTH
+#define MAX_APPLY_GROWTH  8
+#define GROWTH_ADAPTATION 1.5
+#define MIN_REDUCTION     .05
+#define MAX_SEARCH_SHARE  .5
+#define GROWTH_FOCUS      .75
+
+/****************************************************************************************
+ * policy
+ ****************************************************************************************/
+
+void sdd_manager_set_auto_search_policy(char policy, SddManager* manager) {
+  CHECK_ERROR(policy!='f' && policy!='g',"\nerror in %s: policy must be 'f' or 'g'\n","sdd_manager_set_auto_search_policy");
+  manager->auto_search_policy    = policy;
+  manager->auto_global_growth    = GLOBAL_GROWTH;
+  manager->auto_local_growth     = LOCAL_GROWTH;
+  manager->auto_apply_growth     = APPLY_GROWTH;
+  manager->auto_apply_time       = 0;
+  manager->auto_search_time_mark = manager->stats.auto_search_time;
+}
+
+//returns the growth threshold that triggers searches after top-level applies ('g' for
+//global growth, 'l' for local growth) or recursive applies ('a' for apply growth)
+float sdd_manager_auto_search_growth(char threshold, SddManager* manager) {
+  int adaptive = manager->auto_search_policy=='g';
+  switch(threshold) {
+    case 'g': return adaptive? manager->auto_global_growth: GLOBAL_GROWTH;
+    case 'l': return adaptive? manager->auto_local_growth: LOCAL_GROWTH;
+    case 'a': return adaptive? manager->auto_apply_growth: APPLY_GROWTH;
+  }
+  CHECK_ERROR(1,"\nerror in %s: threshold must be 'g', 'l' or 'a'\n","sdd_manager_auto_search_growth");
+  return 0;
+}
+
 /****************************************************************************************
  * search 
  ****************************************************************************************/
 
 void try_auto_gc_and_minimize(Vtree* vtree, SddManager* manager) {
   assert(manager->auto_gc_and_search_on);
+  sdd_manager_flush_deferred_refs(manager); //triggers below depend on exact live/dead counts
   
   int top_level_apply = root_apply(manager);
   int searched = top_level_apply? try_auto_minimize_top(vtree,manager): 
                                   try_auto_minimize_recursive(vtree,manager);  
   
   //search invokes gc
-  if(top_level_apply && !searched) { //try gc
+  if(top_level_apply && !searched && manager->gc_step_budget) { //incremental gc
+    ++manager->auto_gc_invocation_count;
+    sdd_manager_gc_step(manager->gc_step_budget,manager); //bounded pause
+  }
+  else if(top_level_apply && !searched) { //try gc
     SddSize dead  = sdd_manager_dead_count(manager)-manager->auto_apply_outside_dead_count; //apply vtree
     SddSize live  = sdd_manager_live_count(manager)-manager->auto_apply_outside_live_count; //apply vtree
     SddSize all   = dead+live;
@@ -91,14 +154,19 @@ int try_auto_minimize_top(Vtree* vtree, SddManager* manager) {
   SddSize last_size = manager->vtree->auto_last_search_live_size; //since last search
   
   if(cur_size < last_size) return 0;
+
+  int adaptive        = manager->auto_search_policy=='g';
+  float global_growth = adaptive? manager->auto_global_growth: GLOBAL_GROWTH;
+  float local_growth  = adaptive? manager->auto_local_growth: LOCAL_GROWTH;
+  if(adaptive && cur_size < MIN_SEARCH_SIZE) return 0;
   
   //sizes of apply vtree
   SddSize out_apply_size  = manager->auto_apply_outside_live_size; //size outside apply vtree
   SddSize cur_apply_size  = sdd_manager_live_size(manager)-out_apply_size; //size of apply vtree, now
   SddSize last_apply_size = vtree->auto_last_search_live_size; //size of apply vtree, after last search
   
-  int global = !out_apply_size && cur_size >= GLOBAL_GROWTH*last_size; //manager vtree grew enough
-  int local  = out_apply_size  && cur_apply_size >= LOCAL_GROWTH*last_apply_size; //apply vtree grew enough
+  int global = !out_apply_size && cur_size >= global_growth*last_size; //manager vtree grew enough
+  int local  = out_apply_size  && cur_apply_size >= local_growth*last_apply_size; //apply vtree grew enough
    
   Vtree* root = (out_apply_size && manager->auto_local_gc_and_search_on==0)? manager->vtree: vtree;
   
@@ -106,8 +174,17 @@ int try_auto_minimize_top(Vtree* vtree, SddManager* manager) {
     ++manager->auto_search_invocation_count;
     if(out_apply_size) ++manager->auto_search_invocation_count_global;
     else ++manager->auto_search_invocation_count_local;
-    root = search(root,manager); //root may have changed
-    save_size(root); //establish baseline for next search
+    Vtree* focus = adaptive? growth_focus(root): root;
+    if(focus==root) root = search(root,manager); //root may have changed
+    else search(focus,manager); //root is unchanged
+    if(adaptive) {
+      //searches (including recursive ones) and applies since the last top-level search
+      clock_t search_time = manager->stats.auto_search_time-manager->auto_search_time_mark;
+      adapt_growth(cur_size,search_time,manager->auto_apply_time,manager);
+      manager->auto_apply_time       = 0;
+      manager->auto_search_time_mark = manager->stats.auto_search_time;
+    }
+    save_size(root); //establish baseline for next search (also outside a focus)
     return 1;
   }
   else return 0;
@@ -129,7 +206,10 @@ int try_auto_minimize_recursive(Vtree* vtree, SddManager* manager) {
   SddSize cur_apply_size  = sdd_manager_live_size(manager)-manager->auto_apply_outside_live_size; //now
   SddSize last_apply_size = apply_vtree->auto_last_search_live_size; //since last search inside top-level apply
 
-  if(cur_apply_size < APPLY_GROWTH*last_apply_size) return 0; //apply vtree did not grow enough
+  int adaptive       = manager->auto_search_policy=='g';
+  float apply_growth = adaptive? manager->auto_apply_growth: APPLY_GROWTH;
+  if(cur_apply_size < apply_growth*last_apply_size) return 0; //apply vtree did not grow enough
+  if(adaptive && cur_apply_size < MIN_SEARCH_SIZE) return 0; //too small to pay off
   
   //this vtree   
   SddSize cur_vtree_size   = sdd_vtree_live_size(vtree);
@@ -148,6 +228,69 @@ int try_auto_minimize_recursive(Vtree* vtree, SddManager* manager) {
   else return 0;
 }
     
+/****************************************************************************************
+ * adaptive growth policy
+ ****************************************************************************************/
+
+static inline
+SddSize growth_of(Vtree* vtree, SddSize live_size) {
+  SddSize last_size = vtree->auto_last_search_live_size;
+  return live_size > last_size? live_size-last_size: 0;
+}
+
+//returns the smallest subtree of vtree that accounts for most of its growth since the
+//last search
+static
+Vtree* growth_focus(Vtree* vtree) {
+  SddSize live_size = sdd_vtree_live_size(vtree);
+  while(INTERNAL(vtree)) {
+    SddSize growth = growth_of(vtree,live_size);
+    if(growth==0) break;
+    Vtree* left  = vtree->left;
+    Vtree* right = vtree->right;
+    SddSize left_size  = sdd_vtree_live_size(left);
+    SddSize right_size = sdd_vtree_live_size(right);
+    if(INTERNAL(left) && growth_of(left,left_size) >= GROWTH_FOCUS*growth) {
+      vtree     = left;
+      live_size = left_size;
+    }
+    else if(INTERNAL(right) && growth_of(right,right_size) >= GROWTH_FOCUS*growth) {
+      vtree     = right;
+      live_size = right_size;
+    }
+    else break;
+  }
+  return vtree;
+}
+
+static inline
+float clamp_growth(float growth, float min, float max) {
+  return growth < min? min: growth > max? max: growth;
+}
+
+//raises or lowers the growth thresholds based on the reduction achieved by the last
+//search, and the share of time taken by searches (compared to applies) since the
+//previous top-level search
+static
+void adapt_growth(SddSize init_size, clock_t search_time, clock_t apply_time, SddManager* manager) {
+  SddSize size    = sdd_manager_live_size(manager);
+  float reduction = init_size && size < init_size? ((float)(init_size-size))/init_size: 0;
+  float share     = search_time+apply_time? ((float)search_time)/(search_time+apply_time): 0;
+
+  float scale;
+  if(reduction < MIN_REDUCTION || share > MAX_SEARCH_SHARE) scale = GROWTH_ADAPTATION; //wasteful
+  else if(reduction >= 2*MIN_REDUCTION && share <= MAX_SEARCH_SHARE/2) scale = 1/GROWTH_ADAPTATION; //fruitful
+  else return;
+
+  //thresholds are scaled in terms of the growth they allow (threshold-1)
+  float global = 1+(manager->auto_global_growth-1)*scale;
+  float local  = 1+(manager->auto_local_growth-1)*scale;
+  float apply  = 1+(manager->auto_apply_growth-1)*scale;
+  manager->auto_global_growth = clamp_growth(global,MIN_GLOBAL_GROWTH,MAX_GLOBAL_GROWTH);
+  manager->auto_local_growth  = clamp_growth(local,MIN_LOCAL_GROWTH,MAX_LOCAL_GROWTH);
+  manager->auto_apply_growth  = clamp_growth(apply,MIN_APPLY_GROWTH,MAX_APPLY_GROWTH);
+}
+
 /****************************************************************************************
  * saving sizes after search
  ****************************************************************************************/
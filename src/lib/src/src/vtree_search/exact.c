@@ -0,0 +1,757 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//vtree_operations/dissect.c
+Vtree* right_linearize_vtree(Vtree* vtree, SddManager* manager);
+
+//vtree_operations/limits.c
+int search_aborted(SddManager* manager);
+int exceeded_search_time_limit(SddManager* manager);
+
+/****************************************************************************************
+ * Exact vtree search for small windows: a finishing pass for local search. It is off
+ * by default (k=0) since it trades search time for size (see tests/bench/bench_exact.c).
+ *
+ * A window is a maximal subtree W of the vtree with at most k variables (see
+ * sdd_manager_set_vtree_search_exact_window). Vtree operations inside W do not change
+ * sdd nodes outside W, so the sdd nodes normalized for W are fixed by their "entry"
+ * functions: the live nodes in W referenced from outside W (by nodes or users).
+ *
+ * The size of the sdd nodes in W is then computed exactly for any shape of W, using
+ * truth tables over the k variables of W. For a set F of functions over variables Y,
+ * split into L (left) and R (right):
+ *
+ * --a function in F that only mentions L (R) is normalized in the left (right) child
+ * --any other function g is normalized here, and its compressed (L,R)-partition has one
+ *   element for each distinct cofactor g|l, for l an assignment to L: the sub is the
+ *   cofactor and the prime is the disjunction of the l's leading to it
+ * --literals and constants contribute nothing
+ *
+ * so size(F,Y) = min over splits (L,R) of Y of
+ *
+ *   [sum of partition sizes] + size(F_L,L) + size(F_R,R)
+ *
+ * where F_L (F_R) collects the primes (subs) and the functions of F over L (R). The
+ * minimum is computed with memoization on (F,Y), and branch-and-bound over splits (the
+ * memo keeps lower bounds for states whose size exceeded the bound they were given).
+ *
+ * If the optimal size is smaller than the current size of W, the optimal shape is
+ * installed using vtree operations: W is right-linearized, its variables are put in
+ * the optimal order (adjacent swaps), and the shape is then built by rotations. These
+ * operations are not limited, since the final size is known to be smaller (intermediate
+ * sizes are exponential only in k).
+ *
+ * Windows are optimized in decreasing order of their live size. The search for a window
+ * is abandoned when the number of (F,Y) states exceeds EXACT_WINDOW_STATE_LIMIT, or when
+ * the search time limit is exceeded (limited search).
+ ****************************************************************************************/
+
+typedef unsigned long Word;
+#define WORD_BITS (8*sizeof(Word))
+
+#define EXACT_HASH_SIZE 65521
+#define EXACT_INFINITY ((SddSize)-1)
+
+//(F,Y) states and the best split found for them
+typedef struct exact_memo_t {
+  unsigned vars; //Y
+  SddSize count; //|F|
+  SddSize* set; //ids of functions in F (sorted)
+  SddSize cost; //exact when split is not 0, otherwise a lower bound
+  unsigned split; //L for the best split
+  struct exact_memo_t* next;
+} ExactMemo;
+
+//(L,R)-partitions of functions
+typedef struct exact_partition_t {
+  SddSize function; //id of g
+  unsigned split; //L
+  SddSize size; //number of elements
+  SddSize* primes; //ids of primes
+  SddSize* subs; //ids of subs
+  struct exact_partition_t* next;
+} ExactPartition;
+
+//live nodes of a window (open addressing on node ids)
+typedef struct {
+  SddNode* node; //NULL for empty slots
+  SddSize parents; //number of references from live nodes in the window
+  SddSize table; //id of the truth table of node
+} ExactNode;
+
+typedef struct {
+  SddLiteral var_count; //k: bit i of a table index is the value of the ith variable of W
+  SddSize bit_count; //2^k
+  SddSize words; //words per truth table
+  //hash-consed truth tables: table i is at tables+i*words
+  Word* tables;
+  unsigned* supports; //support of each table (bit i set iff it mentions variable i)
+  SddSize table_count;
+  SddSize table_capacity;
+  SddSize* table_heads; //ids+1 (0 for empty)
+  SddSize* table_nexts; //ids+1 (0 for end)
+  Word* scratch; //work space for a table
+  SddSize* elements; //work space for partitions
+  Word* cofactors; //work space for partition sizes
+  ExactMemo** memo;
+  SddSize memo_count;
+  ExactPartition** partitions;
+  ExactNode* nodes;
+  SddSize node_mask; //number of slots-1 (a power of 2 minus 1)
+  SddManager* manager;
+  int limited;
+  int aborted;
+} Exact;
+
+//target shape of a window (leaves are window variables)
+typedef struct {
+  SddLiteral left; //-1 for leaves
+  SddLiteral right;
+  SddLiteral var; //window variable of a leaf
+  SddLiteral leaf_count;
+} ExactShape;
+
+//local declarations
+static SddSize best_cost(unsigned vars, SddSize count, SddSize* set, SddSize bound, Exact* e);
+
+/****************************************************************************************
+ * truth tables
+ ****************************************************************************************/
+
+#define TABLE(i,e) ((e)->tables+(i)*(e)->words)
+#define GET_BIT(t,a) (((t)[(a)/WORD_BITS]>>((a)%WORD_BITS))&1)
+#define SET_BIT(t,a) ((t)[(a)/WORD_BITS] |= ((Word)1)<<((a)%WORD_BITS))
+
+static inline
+SddSize table_hash(Word* table, Exact* e) {
+  SddSize h = 0;
+  for(SddSize w=0; w<e->words; w++) h = 16777619*h+table[w];
+  return h % EXACT_HASH_SIZE;
+}
+
+static
+unsigned table_support(Word* table, Exact* e) {
+  unsigned support = 0;
+  for(SddLiteral i=0; i<e->var_count; i++) {
+    SddSize bit = ((SddSize)1)<<i;
+    for(SddSize a=0; a<e->bit_count; a++) {
+      if((a&bit)==0 && GET_BIT(table,a)!=GET_BIT(table,a|bit)) {
+        support |= bit;
+        break;
+      }
+    }
+  }
+  return support;
+}
+
+//returns the id of table (adding it if it is new)
+static
+SddSize table_id(Word* table, Exact* e) {
+  SddSize h = table_hash(table,e);
+  for(SddSize id=e->table_heads[h]; id; id=e->table_nexts[id-1]) {
+    if(memcmp(TABLE(id-1,e),table,e->words*sizeof(Word))==0) return id-1;
+  }
+  if(e->table_count==e->table_capacity) {
+    e->table_capacity = 2*e->table_capacity+64;
+    REALLOC(e->tables,Word,e->table_capacity*e->words,"table_id");
+    REALLOC(e->supports,unsigned,e->table_capacity,"table_id");
+    REALLOC(e->table_nexts,SddSize,e->table_capacity,"table_id");
+  }
+  SddSize id = e->table_count++;
+  memcpy(TABLE(id,e),table,e->words*sizeof(Word));
+  e->supports[id]    = table_support(table,e);
+  e->table_nexts[id] = e->table_heads[h];
+  e->table_heads[h]  = id+1;
+  return id;
+}
+
+//functions that contribute to the size of sdds: those mentioning two variables or more
+static inline
+int is_decomposition(SddSize id, Exact* e) {
+  unsigned s = e->supports[id];
+  return s&(s-1);
+}
+
+/****************************************************************************************
+ * partitions
+ ****************************************************************************************/
+
+//the number of elements in the compressed partition of g for split: the number of
+//distinct cofactors g|l, with cofactors represented compactly over the variables of g
+//outside split
+static
+SddSize partition_size(SddSize g, unsigned split, Exact* e) {
+  Word* table     = TABLE(g,e);
+  unsigned r_vars = e->supports[g]&~split;
+  SddSize words   = ((((SddSize)1)<<__builtin_popcount(r_vars))+WORD_BITS-1)/WORD_BITS;
+  Word* cofactors = e->cofactors;
+  SddSize size = 0;
+  unsigned l = 0;
+  do {
+    Word* cofactor = cofactors+size*words;
+    memset(cofactor,0,words*sizeof(Word));
+    SddSize i = 0;
+    unsigned r = 0;
+    do {
+      if(GET_BIT(table,l|r)) SET_BIT(cofactor,i);
+      ++i;
+      r = (r-r_vars)&r_vars; //next assignment to r_vars
+    } while(r);
+    SddSize j = 0;
+    while(j<size && memcmp(cofactors+j*words,cofactor,words*sizeof(Word))) ++j;
+    if(j==size) ++size; //new cofactor
+    l = (l-split)&split; //next assignment to split
+  } while(l);
+  return size;
+}
+
+//the compressed (split,vars-split)-partition of function g
+//primes and subs are computed only when full is 1 (otherwise, only the size is)
+static
+ExactPartition* partition(SddSize g, unsigned split, int full, Exact* e) {
+  split &= e->supports[g]; //the partition depends only on the variables of g
+  SddSize h = (16777619*g+split) % EXACT_HASH_SIZE;
+  ExactPartition* p = e->partitions[h];
+  while(p && (p->function!=g || p->split!=split)) p = p->next;
+
+  if(p==NULL) {
+    MALLOC(p,ExactPartition,"partition");
+    p->function = g;
+    p->split    = split;
+    p->size     = partition_size(g,split,e);
+    p->primes   = NULL;
+    p->subs     = NULL;
+    p->next     = e->partitions[h];
+    e->partitions[h] = p;
+  }
+  if(!full || p->primes) return p;
+
+  Word* table      = TABLE(g,e);
+  Word* cofactor   = e->scratch;
+  SddSize* element = e->elements; //element[l]: element of assignment l to split
+  CALLOC(p->subs,SddSize,p->size,"partition");
+  CALLOC(p->primes,SddSize,p->size,"partition");
+  SddSize size = 0;
+
+  //subs: distinct cofactors g|l
+  unsigned l = 0;
+  do {
+    memset(cofactor,0,e->words*sizeof(Word));
+    for(SddSize a=0; a<e->bit_count; a++) {
+      if(GET_BIT(table,(a&~split)|l)) SET_BIT(cofactor,a);
+    }
+    SddSize sub = table_id(cofactor,e);
+    table = TABLE(g,e); //tables may have been reallocated
+    SddSize i = 0;
+    while(i<size && p->subs[i]!=sub) ++i;
+    if(i==size) p->subs[size++] = sub;
+    element[l] = i;
+    l = (l-split)&split; //next assignment to split
+  } while(l);
+  assert(size==p->size);
+
+  //primes: disjunction of the assignments leading to each sub
+  Word* prime = e->scratch;
+  for(SddSize i=0; i<size; i++) {
+    memset(prime,0,e->words*sizeof(Word));
+    for(SddSize a=0; a<e->bit_count; a++) {
+      if(element[a&split]==i) SET_BIT(prime,a);
+    }
+    p->primes[i] = table_id(prime,e);
+  }
+
+  return p;
+}
+
+/****************************************************************************************
+ * sets of functions
+ ****************************************************************************************/
+
+static
+int id_cmp(const void* i1, const void* i2) {
+  SddSize id1 = *((const SddSize*)i1);
+  SddSize id2 = *((const SddSize*)i2);
+  return id1 < id2? -1: id1 > id2? 1: 0;
+}
+
+//sorts set and removes duplicates, returning the new count
+static
+SddSize normalize_set(SddSize count, SddSize* set) {
+  if(count==0) return 0;
+  qsort(set,count,sizeof(SddSize),id_cmp);
+  SddSize j = 0;
+  for(SddSize i=1; i<count; i++) if(set[i]!=set[j]) set[++j] = set[i];
+  return j+1;
+}
+
+//distributes the functions of set on the two sides of split (a subset of their variables):
+//--returns the total size of partitions normalized for vars (EXACT_INFINITY if this
+//  reaches bound, in which case nothing is distributed)
+//--the two sets (to be freed) collect primes (subs) and functions mentioning only split
+//  (vars-split), keeping only decompositions
+static
+SddSize split_set(unsigned split, SddSize count, SddSize* set, SddSize bound,
+                  SddSize* l_count, SddSize** l_set, SddSize* r_count, SddSize** r_set, Exact* e) {
+  SddSize size = 0, l_max = 0, r_max = 0;
+  for(SddSize i=0; i<count; i++) {
+    unsigned support = e->supports[set[i]];
+    if((support&~split)==0) ++l_max;
+    else if((support&split)==0) ++r_max;
+    else {
+      ExactPartition* p = partition(set[i],split,0,e);
+      size  += p->size;
+      l_max += p->size;
+      r_max += p->size;
+      if(size>=bound) return EXACT_INFINITY;
+    }
+  }
+
+  CALLOC(*l_set,SddSize,l_max+1,"split_set");
+  CALLOC(*r_set,SddSize,r_max+1,"split_set");
+  SddSize lc = 0, rc = 0;
+  for(SddSize i=0; i<count; i++) {
+    unsigned support = e->supports[set[i]];
+    if((support&~split)==0) (*l_set)[lc++] = set[i];
+    else if((support&split)==0) (*r_set)[rc++] = set[i];
+    else {
+      ExactPartition* p = partition(set[i],split,1,e);
+      for(SddSize j=0; j<p->size; j++) {
+        if(is_decomposition(p->primes[j],e)) (*l_set)[lc++] = p->primes[j];
+        if(is_decomposition(p->subs[j],e))   (*r_set)[rc++] = p->subs[j];
+      }
+    }
+  }
+  *l_count = normalize_set(lc,*l_set);
+  *r_count = normalize_set(rc,*r_set);
+  return size;
+}
+
+/****************************************************************************************
+ * optimal sizes
+ ****************************************************************************************/
+
+static
+ExactMemo** lookup_memo(unsigned vars, SddSize count, SddSize* set, Exact* e) {
+  SddSize h = vars;
+  for(SddSize i=0; i<count; i++) h = 16777619*h+set[i];
+  ExactMemo** location = e->memo+(h % EXACT_HASH_SIZE);
+  while(*location) {
+    ExactMemo* m = *location;
+    if(m->vars==vars && m->count==count && memcmp(m->set,set,count*sizeof(SddSize))==0) break;
+    location = &(m->next);
+  }
+  return location;
+}
+
+//the smallest size of sdds for the functions in set, over all vtrees for vars, when this
+//is smaller than bound; otherwise, a lower bound on this size which is >= bound
+//
+//every function in set is a distinct decomposition with at least two elements, so
+//the size is at least twice the number of functions
+static
+SddSize best_cost(unsigned vars, SddSize count, SddSize* set, SddSize bound, Exact* e) {
+  if(count==0 || e->aborted) return 0;
+  if(2*count>=bound) return 2*count;
+
+  ExactMemo** location = lookup_memo(vars,count,set,e);
+  ExactMemo* m = *location;
+  if(m && (m->split || m->cost>=bound)) return m->cost; //exact or a good enough bound
+
+  if(e->memo_count>=EXACT_WINDOW_STATE_LIMIT ||
+     (e->limited && e->memo_count%64==0 && exceeded_search_time_limit(e->manager))) {
+    e->aborted = 1;
+    return 0;
+  }
+
+  SddSize best_size = bound;
+  unsigned best_split = 0;
+  for(unsigned split=(vars-1)&vars; split; split=(split-1)&vars) { //proper, non-empty subsets
+    SddSize l_count, r_count;
+    SddSize* l_set;
+    SddSize* r_set;
+    SddSize size = split_set(split,count,set,best_size,&l_count,&l_set,&r_count,&r_set,e);
+    if(size==EXACT_INFINITY) continue;
+    //the two children are at least twice the number of their functions
+    if(size+2*(l_count+r_count)<best_size) {
+      size += best_cost(split,l_count,l_set,best_size-size-2*r_count,e);
+      if(size+2*r_count<best_size) {
+        size += best_cost(vars^split,r_count,r_set,best_size-size,e);
+        if(size<best_size) {
+          best_size  = size;
+          best_split = split;
+        }
+      }
+    }
+    free(l_set);
+    free(r_set);
+  }
+
+  if(m==NULL) {
+    MALLOC(m,ExactMemo,"best_cost");
+    CALLOC(m->set,SddSize,count,"best_cost");
+    memcpy(m->set,set,count*sizeof(SddSize));
+    m->vars   = vars;
+    m->count  = count;
+    m->next   = NULL;
+    location  = lookup_memo(vars,count,set,e); //memo may have changed
+    *location = m;
+    ++e->memo_count;
+  }
+  m->cost  = best_size; //exact if a split was found, otherwise a lower bound (bound)
+  m->split = best_split;
+  return best_size;
+}
+
+//constructs the optimal shape for the functions in set (after best_cost has been called)
+//returns the index of the shape root in shapes
+static
+SddLiteral best_shape(unsigned vars, SddSize count, SddSize* set, ExactShape* shapes, SddLiteral* shape_count, Exact* e) {
+  SddLiteral index   = (*shape_count)++;
+  ExactShape* shape  = shapes+index;
+  if((vars&(vars-1))==0) { //single variable
+    shape->left       = shape->right = -1;
+    shape->var        = __builtin_ctz(vars);
+    shape->leaf_count = 1;
+    return index;
+  }
+
+  unsigned split = vars&(~vars+1); //any shape when there are no functions: right-linear
+  if(count) {
+    ExactMemo* m = *lookup_memo(vars,count,set,e);
+    assert(m && m->split);
+    split = m->split;
+  }
+  SddSize l_count, r_count;
+  SddSize* l_set;
+  SddSize* r_set;
+  split_set(split,count,set,EXACT_INFINITY,&l_count,&l_set,&r_count,&r_set,e);
+  SddLiteral left  = best_shape(split,l_count,l_set,shapes,shape_count,e);
+  SddLiteral right = best_shape(vars^split,r_count,r_set,shapes,shape_count,e);
+  free(l_set);
+  free(r_set);
+
+  shape = shapes+index;
+  shape->left       = left;
+  shape->right      = right;
+  shape->leaf_count = shapes[left].leaf_count+shapes[right].leaf_count;
+  return index;
+}
+
+/****************************************************************************************
+ * truth tables of sdd nodes in a window
+ *
+ * node data is kept in a table of the window rather than in the index field of nodes,
+ * which is used by other sdd algorithms (e.g., weighted model counting)
+ ****************************************************************************************/
+
+//returns the slot of node (adding it if it is new)
+static
+ExactNode* exact_node(SddNode* node, Exact* e) {
+  SddSize h = (node->id*2654435761u) & e->node_mask;
+  while(e->nodes[h].node!=node) {
+    if(e->nodes[h].node==NULL) {
+      e->nodes[h].node = node;
+      break;
+    }
+    h = (h+1) & e->node_mask;
+  }
+  return e->nodes+h;
+}
+
+static
+SddSize node_table(SddNode* node, Vtree** leaves, Exact* e) {
+  if(node->type==DECOMPOSITION) return exact_node(node,e)->table;
+  Word* table = e->scratch;
+  memset(table,0,e->words*sizeof(Word));
+  if(node->type==TRUE) {
+    for(SddSize a=0; a<e->bit_count; a++) SET_BIT(table,a);
+  }
+  else if(node->type==LITERAL) {
+    SddLiteral literal = LITERAL_OF(node);
+    SddLiteral i = 0;
+    while(leaves[i]->var!=labs(literal)) ++i;
+    for(SddSize a=0; a<e->bit_count; a++) {
+      if(((a>>i)&1)==(literal>0)) SET_BIT(table,a);
+    }
+  }
+  return table_id(table,e);
+}
+
+//sets the table of each live node normalized for vtree
+static
+void set_node_tables(Vtree* vtree, Vtree** leaves, Exact* e) {
+  if(LEAF(vtree)) return;
+  set_node_tables(vtree->left,leaves,e);
+  set_node_tables(vtree->right,leaves,e);
+  Word* table;
+  CALLOC(table,Word,e->words,"set_node_tables");
+  FOR_each_sdd_node_normalized_for(n,vtree,{
+    if(n->ref_count) { //live
+      memset(table,0,e->words*sizeof(Word));
+      FOR_each_prime_sub_of_node(prime,sub,n,{
+        SddSize p = node_table(prime,leaves,e);
+        SddSize s = node_table(sub,leaves,e);
+        for(SddSize w=0; w<e->words; w++) table[w] |= TABLE(p,e)[w]&TABLE(s,e)[w];
+      });
+      exact_node(n,e)->table = table_id(table,e);
+    }
+  });
+  free(table);
+}
+
+/****************************************************************************************
+ * installing a shape using vtree operations
+ ****************************************************************************************/
+
+//the location of the pth node of a right-linear vtree
+static
+Vtree** chain_location(Vtree** root_location, SddLiteral p) {
+  Vtree** location = root_location;
+  while(p--) location = &((*location)->right);
+  return location;
+}
+
+//the pth leaf of a right-linear vtree with k leaves
+static
+Vtree* chain_leaf(Vtree** root_location, SddLiteral p, SddLiteral k) {
+  if(p==k-1) return (*chain_location(root_location,p-1))->right;
+  else return (*chain_location(root_location,p))->left;
+}
+
+//swaps the pth and (p+1)th leaves of a right-linear vtree
+static
+void chain_transpose(Vtree** root_location, SddLiteral p, SddManager* manager) {
+  Vtree** location = chain_location(root_location,p);
+  Vtree* c = *location;
+  if(LEAF(c->right)) sdd_vtree_swap(c,manager,0); //(x y) ==> (y x)
+  else { //(x (y r)) ==> ((x y) r) ==> ((y x) r) ==> (y (x r))
+    sdd_vtree_rotate_left(c->right,manager,0);
+    sdd_vtree_swap((*location)->left,manager,0);
+    sdd_vtree_rotate_right(*location,manager,0);
+  }
+}
+
+static void build_from_left(Vtree** location, SddLiteral index, ExactShape* shapes, SddManager* manager);
+
+//vtree at location is right-linear, with the leaves of shape in order
+static
+void build_from_right(Vtree** location, SddLiteral index, ExactShape* shapes, SddManager* manager) {
+  ExactShape* shape = shapes+index;
+  if(shape->left==-1) return;
+  //(x1 (x2 (x3 r))) ==> ((x1 x2) (x3 r)) ==> (((x1 x2) x3) r)
+  for(SddLiteral i=1; i<shapes[shape->left].leaf_count; i++) {
+    sdd_vtree_rotate_left((*location)->right,manager,0);
+  }
+  build_from_left(&((*location)->left),shape->left,shapes,manager);
+  build_from_right(&((*location)->right),shape->right,shapes,manager);
+}
+
+//vtree at location is left-linear, with the leaves of shape in order
+static
+void build_from_left(Vtree** location, SddLiteral index, ExactShape* shapes, SddManager* manager) {
+  ExactShape* shape = shapes+index;
+  if(shape->left==-1) return;
+  //(((l x1) x2) x3) ==> ((l x1) (x2 x3)) ==> (l (x1 (x2 x3)))
+  for(SddLiteral i=1; i<shapes[shape->right].leaf_count; i++) {
+    sdd_vtree_rotate_right(*location,manager,0);
+  }
+  build_from_left(&((*location)->left),shape->left,shapes,manager);
+  build_from_right(&((*location)->right),shape->right,shapes,manager);
+}
+
+static
+void shape_leaves(SddLiteral index, ExactShape* shapes, Vtree** leaves, Vtree** order, SddLiteral* count) {
+  ExactShape* shape = shapes+index;
+  if(shape->left==-1) order[(*count)++] = leaves[shape->var];
+  else {
+    shape_leaves(shape->left,shapes,leaves,order,count);
+    shape_leaves(shape->right,shapes,leaves,order,count);
+  }
+}
+
+static
+void install_shape(Vtree* vtree, SddLiteral root, ExactShape* shapes, Vtree** leaves, SddManager* manager) {
+  SddLiteral k = vtree->var_count;
+  Vtree** root_location = sdd_vtree_location(vtree,manager);
+  right_linearize_vtree(vtree,manager);
+
+  //order variables
+  Vtree** order;
+  CALLOC(order,Vtree*,k,"install_shape");
+  SddLiteral count = 0;
+  shape_leaves(root,shapes,leaves,order,&count);
+  for(SddLiteral i=0; i<k; i++) {
+    SddLiteral j = i;
+    while(chain_leaf(root_location,j,k)!=order[i]) ++j;
+    while(j>i) chain_transpose(root_location,--j,manager);
+  }
+  free(order);
+
+  build_from_right(root_location,root,shapes,manager);
+}
+
+/****************************************************************************************
+ * optimizing a window
+ ****************************************************************************************/
+
+//returns 1 if the size of window was reduced
+static
+int optimize_window(Vtree* window, SddManager* manager, int limited) {
+  SddLiteral k = window->var_count;
+  Exact e;
+  e.var_count      = k;
+  e.bit_count      = ((SddSize)1)<<k;
+  e.words          = e.bit_count<WORD_BITS? 1: e.bit_count/WORD_BITS;
+  e.tables         = NULL;
+  e.supports       = NULL;
+  e.table_count    = 0;
+  e.table_capacity = 0;
+  e.table_nexts    = NULL;
+  e.memo_count     = 0;
+  e.manager        = manager;
+  e.limited        = limited;
+  e.aborted        = 0;
+  CALLOC(e.table_heads,SddSize,EXACT_HASH_SIZE,"optimize_window");
+  CALLOC(e.scratch,Word,e.words,"optimize_window");
+  CALLOC(e.elements,SddSize,e.bit_count,"optimize_window");
+  CALLOC(e.cofactors,Word,e.words+e.bit_count,"optimize_window");
+  CALLOC(e.memo,ExactMemo*,EXACT_HASH_SIZE,"optimize_window");
+  CALLOC(e.partitions,ExactPartition*,EXACT_HASH_SIZE,"optimize_window");
+
+  Vtree** leaves;
+  CALLOC(leaves,Vtree*,k,"optimize_window");
+  SddLiteral i = 0;
+  FOR_each_leaf_vtree_node(v,window,leaves[i++] = v);
+
+  //entry nodes: live nodes referenced from outside the window
+  SddSize count = 0;
+  FOR_each_decomposition_in(n,window,if(n->ref_count) ++count);
+  SddSize slots = 1;
+  while(slots<2*count) slots *= 2;
+  CALLOC(e.nodes,ExactNode,slots,"optimize_window");
+  e.node_mask = slots-1;
+  FOR_each_decomposition_in(n,window,{
+    if(n->ref_count) { //live
+      exact_node(n,&e);
+      FOR_each_prime_sub_of_node(prime,sub,n,{
+        if(prime->type==DECOMPOSITION) ++exact_node(prime,&e)->parents;
+        if(sub->type==DECOMPOSITION) ++exact_node(sub,&e)->parents;
+      });
+    }
+  });
+
+  set_node_tables(window,leaves,&e);
+  SddSize* set;
+  CALLOC(set,SddSize,count+1,"optimize_window");
+  count = 0;
+  for(SddSize j=0; j<=e.node_mask; j++) {
+    ExactNode* n = e.nodes+j;
+    if(n->node && n->node->ref_count > n->parents) set[count++] = n->table;
+  }
+  count = normalize_set(count,set);
+
+  unsigned vars   = (1u<<k)-1;
+  SddSize cur_size = sdd_vtree_live_size(window);
+  SddSize size     = best_cost(vars,count,set,cur_size,&e); //only smaller sizes matter
+  int reduced      = !e.aborted && size<cur_size;
+
+  if(reduced) {
+    ExactShape* shapes;
+    CALLOC(shapes,ExactShape,2*k,"optimize_window");
+    SddLiteral shape_count = 0;
+    SddLiteral root = best_shape(vars,count,set,shapes,&shape_count,&e);
+    install_shape(window,root,shapes,leaves,manager);
+    free(shapes);
+  }
+
+  free(set);
+  free(leaves);
+  for(SddSize h=0; h<EXACT_HASH_SIZE; h++) {
+    for(ExactMemo* m=e.memo[h]; m;) {
+      ExactMemo* next = m->next;
+      free(m->set);
+      free(m);
+      m = next;
+    }
+    for(ExactPartition* p=e.partitions[h]; p;) {
+      ExactPartition* next = p->next;
+      free(p->primes);
+      free(p->subs);
+      free(p);
+      p = next;
+    }
+  }
+  free(e.memo);
+  free(e.partitions);
+  free(e.tables);
+  free(e.supports);
+  free(e.table_heads);
+  free(e.table_nexts);
+  free(e.scratch);
+  free(e.elements);
+  free(e.cofactors);
+  free(e.nodes);
+  return reduced;
+}
+
+/****************************************************************************************
+ * exact search pass
+ ****************************************************************************************/
+
+typedef struct {
+  Vtree* vtree;
+  SddSize size;
+} ExactWindow;
+
+static
+void collect_windows(Vtree* vtree, SddLiteral k, ExactWindow* windows, SddSize* count) {
+  if(vtree->var_count<=k) {
+    //windows with two variables are covered by swaps in local search
+    if(vtree->var_count>=3) {
+      windows[*count].vtree = vtree;
+      windows[*count].size  = sdd_vtree_live_size(vtree);
+      if(windows[*count].size) ++(*count);
+    }
+  }
+  else {
+    collect_windows(vtree->left,k,windows,count);
+    collect_windows(vtree->right,k,windows,count);
+  }
+}
+
+static
+int window_cmp(const void* w1, const void* w2) {
+  SddSize s1 = ((const ExactWindow*)w1)->size;
+  SddSize s2 = ((const ExactWindow*)w2)->size;
+  return s1 > s2? -1: s1 < s2? 1: 0; //decreasing size
+}
+
+//optimizes the maximal windows of vtree, returning the number of windows whose size
+//was reduced
+int exact_window_pass(Vtree* vtree, SddManager* manager, int limited) {
+  SddLiteral k = manager->vtree_ops.exact_window_var_count;
+  if(k<3) return 0;
+
+  ExactWindow* windows;
+  CALLOC(windows,ExactWindow,vtree->var_count,"exact_window_pass");
+  SddSize count = 0;
+  collect_windows(vtree,k,windows,&count);
+  qsort(windows,count,sizeof(ExactWindow),window_cmp);
+
+  int reduced = 0;
+  for(SddSize i=0; i<count && !(limited && search_aborted(manager)); i++) {
+    reduced += optimize_window(windows[i].vtree,manager,limited);
+  }
+
+  free(windows);
+  return reduced;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -16,6 +16,9 @@ int fragment_aborted(SddManager* manager);
 void sdd_manager_init_vtree_size_limit(Vtree* vtree, SddManager* manager);
 void sdd_manager_update_vtree_size_limit(SddManager* manager);
 
+//search_vtree/exact.c
+int exact_window_pass(Vtree* vtree, SddManager* manager, int limited);
+
 //search_vtree/state.c
 int is_virtual_leaf_vtree(Vtree* vtree);
 Vtree* update_vtree_change(Vtree* vtree, SddManager* manager);
@@ -42,6 +45,9 @@ Vtree* update_vtree_change_p(Vtree* vtree, SddManager* manager);
  * 
  * The algorithm is guaranteed to improve the sdd size monotonically through its passes.
  *
+ * Once the passes converge, small subtrees of the vtree are optimized exactly (see
+ * exact.c), unless this is turned off by sdd_manager_set_vtree_search_exact_window().
+ *
  ***************************************************************************************/
 
 /****************************************************************************************
@@ -302,6 +308,11 @@ Vtree* sdd_vtree_minimize_limited_flag(Vtree* vtree, SddManager* manager, int li
   }
   while(!(limited && search_aborted(manager)) && subtree!=NULL && reduction>threshold);
   
+  //finishing pass: exact search over small subtrees (X-constrained vtrees are skipped)
+  if(!(limited && search_aborted(manager)) && (*root_location)->some_X_constrained_vars==0) {
+    exact_window_pass(*root_location,manager,limited);
+  }
+
   assert(verify_X_constrained(manager->vtree));
 
   if(manager->auto_gc_and_search_on) {
@@ -319,12 +330,14 @@ Vtree* sdd_vtree_minimize_limited_flag(Vtree* vtree, SddManager* manager, int li
 
 //unlimited
 Vtree* sdd_vtree_minimize(Vtree* vtree, SddManager* manager) {
-  return sdd_vtree_minimize_limited_flag(vtree,manager,0);
+  WITH_immediate_refs(manager,vtree = sdd_vtree_minimize_limited_flag(vtree,manager,0));
+  return vtree;
 }
 
 //limited
 Vtree* sdd_vtree_minimize_limited(Vtree* vtree, SddManager* manager) {
-  return sdd_vtree_minimize_limited_flag(vtree,manager,1);
+  WITH_immediate_refs(manager,vtree = sdd_vtree_minimize_limited_flag(vtree,manager,1));
+  return vtree;
 }
 
 /****************************************************************************************
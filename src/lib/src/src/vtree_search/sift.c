@@ -0,0 +1,295 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//vtree_operations/limits.c
+void start_search_limits(SddManager* manager);
+void end_search_limits(SddManager* manager);
+int search_aborted(SddManager* manager);
+void start_fragment_limits(SddManager* manager);
+void end_fragment_limits(SddManager* manager);
+int fragment_aborted(SddManager* manager);
+void sdd_manager_init_vtree_size_limit(Vtree* vtree, SddManager* manager);
+void sdd_manager_update_vtree_size_limit(SddManager* manager);
+
+//search_vtree/state.c
+Vtree* update_vtree_change(Vtree* vtree, SddManager* manager);
+Vtree* update_vtree_change_p(Vtree* vtree, SddManager* manager);
+
+/****************************************************************************************
+ * Sifting: a vtree search algorithm that moves one variable at a time.
+ *
+ * A leaf x is moved through the vtree by a sequence of moves, each being a single vtree
+ * operation. Moving x to the right (in the in-order of the vtree):
+ *
+ * --x=left child of p=(x s), s internal: left rotate s,  (x (a b))   ==> ((x a) b)
+ * --x=left child of p=(x s), s leaf    : swap p,         (x s)       ==> (s x)
+ * --x=right child of p, p=left child   : right rotate q, ((s x) c)   ==> (s (x c))
+ * --x=right child of p, p=right child  : left rotate p,  (c (s x))   ==> ((c s) x)
+ *
+ * until x becomes the right child of the vtree root. Moving x to the left is symmetric.
+ * Only swaps change the order of variables, so x passes each other variable once, while
+ * rotations visit the different ways of nesting x between its neighbors.
+ *
+ * Each leaf is first moved to the nearest end of the vtree, then to the other end,
+ * and is finally returned to the position with the smallest sdd size (sdd size is
+ * measured by the manager live size, which differs from the vtree live size by
+ * a constant since nodes outside the vtree are not touched). Moves are recorded so they
+ * can be undone: the inverse of a rotation is the opposite rotation of the same vtree
+ * node, and the inverse of a swap is the swap itself.
+ *
+ * A direction is abandoned when the size grows beyond SIFT_MAX_GROWTH times the best
+ * size found so far, or when a vtree operation fails (limited search). Returning to the
+ * best position is not limited (all states on the way back were visited before).
+ * In a limited search, sifting a leaf plays the role of a fragment search: the fragment
+ * time limit applies to each leaf, and both directions stop once it is exceeded.
+ *
+ * Leaves are sifted in decreasing order of the size of sdd nodes normalized for their
+ * parents (these nodes decompose directly on the leaf variable). These sizes change as
+ * leaves are moved, so the next leaf is selected after each leaf is sifted. Unused
+ * variables are not sifted. Passes are repeated until the reduction in size falls below the convergence
+ * threshold, as in local search (see search.c).
+ *
+ * Sifting does not respect X-constrained vtrees, which are minimized by local search.
+ ****************************************************************************************/
+
+typedef struct {
+  char op; //'l' (left rotate), 'r' (right rotate), 's' (swap)
+  Vtree* vtree;
+} SiftMove;
+
+typedef struct {
+  SddSize count;
+  SddSize capacity;
+  SiftMove* moves;
+} SiftLog;
+
+//local declarations
+static int sift_leaf(Vtree* x, Vtree** root_location, SiftLog* log, SddManager* manager, int limited);
+
+/****************************************************************************************
+ * moves
+ ****************************************************************************************/
+
+static
+int do_move(char op, Vtree* vtree, SddManager* manager, int limited) {
+  switch(op) {
+    case 'l': return sdd_vtree_rotate_left(vtree,manager,limited);
+    case 'r': return sdd_vtree_rotate_right(vtree,manager,limited);
+    default : return sdd_vtree_swap(vtree,manager,limited);
+  }
+}
+
+static
+void undo_move(SiftMove* move, SddManager* manager) {
+  char op = move->op=='l'? 'r': move->op=='r'? 'l': 's';
+  do_move(op,move->vtree,manager,0); //unlimited
+}
+
+//moves leaf x one step to the right (right=1) or left (right=0) and records the move
+//returns 1 if x was moved, 0 if x is at the end or the vtree operation failed
+static
+int move_leaf(int right, Vtree* x, Vtree** root_location, SiftLog* log, SddManager* manager, int limited) {
+  Vtree* p = x->parent;
+  char op;
+  Vtree* v;
+  if((right && p->left==x) || (!right && p->right==x)) { //x moves within p
+    Vtree* s = right? p->right: p->left;
+    if(LEAF(s)) { op = 's'; v = p; }
+    else if(right) { op = 'l'; v = s; }
+    else { op = 'r'; v = p; }
+  }
+  else { //x moves out of p
+    if(p==*root_location) return 0; //end of vtree
+    Vtree* q = p->parent;
+    if(q->left==p) { op = 'r'; v = q; }
+    else { op = 'l'; v = p; }
+  }
+
+  if(!do_move(op,v,manager,limited)) return 0;
+
+  if(log->count==log->capacity) {
+    log->capacity = 2*log->capacity+16;
+    REALLOC(log->moves,SiftMove,log->capacity,"move_leaf");
+  }
+  log->moves[log->count].op    = op;
+  log->moves[log->count].vtree = v;
+  ++log->count;
+  return 1;
+}
+
+//undo moves until count moves are left in log
+static
+void undo_moves(SddSize count, SiftLog* log, SddManager* manager) {
+  while(log->count > count) undo_move(log->moves+(--log->count),manager);
+}
+
+/****************************************************************************************
+ * sifting a leaf
+ ****************************************************************************************/
+
+//moves x in one direction until the end of the vtree, the growth limit, or a failure
+//updates best_size and best (number of moves in log leading to the best position)
+static
+void sift_direction(int right, Vtree* x, Vtree** root_location, SiftLog* log, SddSize* best_size, SddSize* best, SddManager* manager, int limited) {
+  while(!(limited && (search_aborted(manager) || fragment_aborted(manager)))) {
+    if(!move_leaf(right,x,root_location,log,manager,limited)) return;
+    SddSize cur_size = sdd_manager_live_size(manager);
+    if(cur_size < *best_size) {
+      *best_size = cur_size;
+      *best      = log->count;
+      if(limited) sdd_manager_update_vtree_size_limit(manager); //new baseline for size limits
+    }
+    else if(cur_size > SIFT_MAX_GROWTH*(*best_size)) return;
+  }
+}
+
+//moves x to its best position
+//returns 1 if the size was reduced, 0 otherwise
+static
+int sift_leaf(Vtree* x, Vtree** root_location, SiftLog* log, SddManager* manager, int limited) {
+  Vtree* root    = *root_location;
+  int right      = root->last->position-x->position < x->position-root->first->position;
+  SddSize init_size = sdd_manager_live_size(manager);
+  if(limited) start_fragment_limits(manager);
+
+  //first direction (nearest end)
+  SddSize best_size1 = init_size, best1 = 0;
+  log->count = 0;
+  sift_direction(right,x,root_location,log,&best_size1,&best1,manager,limited);
+  SiftMove* moves1 = log->moves;
+  undo_moves(0,log,manager); //back to initial position
+
+  //second direction (moves of first direction are kept for redoing them)
+  SiftLog log2 = {0,0,NULL};
+  SddSize best_size2 = best_size1, best2 = 0;
+  sift_direction(!right,x,root_location,&log2,&best_size2,&best2,manager,limited);
+
+  if(best_size2 < best_size1) undo_moves(best2,&log2,manager); //best is in second direction
+  else { //best is in first direction or is the initial position
+    undo_moves(0,&log2,manager);
+    for(SddSize i=0; i<best1; i++) do_move(moves1[i].op,moves1[i].vtree,manager,0); //unlimited
+  }
+  free(log2.moves);
+  if(limited) end_fragment_limits(manager);
+
+  return sdd_manager_live_size(manager) < init_size;
+}
+
+/****************************************************************************************
+ * sifting all leaves of a vtree
+ ****************************************************************************************/
+
+//returns root of vtree after sifting (vtree may have changed)
+static
+Vtree* sift_pass(Vtree* vtree, SddManager* manager, int limited) {
+  Vtree** root_location = sdd_vtree_location(vtree,manager);
+
+  SddLiteral count = 0;
+  Vtree** leaves; //leaves not sifted yet
+  CALLOC(leaves,Vtree*,sdd_vtree_var_count(vtree),"sift_pass");
+  FOR_each_leaf_vtree_node(v,vtree,{
+    if(v!=vtree && sdd_manager_is_var_used(v->var,manager)) leaves[count++] = v;
+  });
+
+  SiftLog log = {0,0,NULL};
+  while(count && !(limited && search_aborted(manager))) {
+    //leaf with the largest size at its parent (sizes are changed by sifting)
+    SddLiteral next = 0;
+    for(SddLiteral i=1; i<count; i++) {
+      if(sdd_vtree_live_size_at(leaves[i]->parent) > sdd_vtree_live_size_at(leaves[next]->parent)) next = i;
+    }
+    Vtree* leaf  = leaves[next];
+    leaves[next] = leaves[--count];
+    sift_leaf(leaf,root_location,&log,manager,limited);
+  }
+  free(log.moves);
+  free(leaves);
+
+  return *root_location;
+}
+
+/****************************************************************************************
+ * sifting vtree search
+ ****************************************************************************************/
+
+//returns percentage reduction in size
+static
+float size_reduction(SddSize prev_size, SddSize cur_size) {
+  if(prev_size==0 || cur_size>=prev_size) return 0;
+  else return 100.0*(prev_size-cur_size)/prev_size;
+}
+
+//returns new root
+static
+Vtree* sdd_vtree_minimize_sift_limited_flag(Vtree* vtree, SddManager* manager, int limited) {
+  assert(manager->auto_vtree_search_on==0);
+  if(LEAF(vtree)) return vtree;
+
+  manager->auto_vtree_search_on = 1;
+
+  sdd_vtree_garbage_collect(vtree,manager); //local garbage collection
+
+  //identify the subtree to minimize (heuristic)
+  Vtree* subtree = update_vtree_change(vtree,manager); //after gc
+  if(subtree==NULL || LEAF(subtree)) {
+    manager->auto_vtree_search_on = 0;
+    return vtree;
+  }
+
+  Vtree** root_location = sdd_vtree_location(vtree,manager); //remember root location
+  SddSize init_size     = sdd_vtree_live_size(subtree);
+  SddSize out_size      = sdd_manager_live_size(manager)-init_size;
+  float threshold       = manager->vtree_ops.convergence_threshold;
+  int iterations        = 0;
+  float reduction;
+
+  if(limited) {
+    start_search_limits(manager);
+    sdd_manager_init_vtree_size_limit(subtree,manager); //baseline for size limits
+  }
+
+  do { //pass
+    SddSize prev_size = sdd_vtree_live_size(subtree);
+    subtree           = sift_pass(subtree,manager,limited); //possibly new root
+    SddSize cur_size  = sdd_vtree_live_size(subtree);
+    reduction         = size_reduction(prev_size,cur_size);
+    subtree           = update_vtree_change_p(subtree,manager); //identify new subtree to minimize next
+    ++iterations;
+  }
+  while(!(limited && search_aborted(manager)) && subtree!=NULL && INTERNAL(subtree) && reduction>threshold);
+
+  if(manager->auto_gc_and_search_on) {
+    SddSize final_size    = sdd_manager_live_size(manager)-out_size;
+    float total_reduction = size_reduction(init_size,final_size);
+    manager->auto_search_iteration_count += iterations;
+    manager->auto_search_reduction_sum   += total_reduction;
+  }
+
+  manager->auto_vtree_search_on = 0;
+  if(limited) end_search_limits(manager);
+  assert(!FULL_DEBUG || verify_gc(*root_location,manager));
+  return *root_location; //root may have changed due to rotations
+}
+
+//unlimited
+Vtree* sdd_vtree_minimize_sift(Vtree* vtree, SddManager* manager) {
+  if(vtree->some_X_constrained_vars) return sdd_vtree_minimize(vtree,manager);
+  WITH_immediate_refs(manager,vtree = sdd_vtree_minimize_sift_limited_flag(vtree,manager,0));
+  return vtree;
+}
+
+//limited: has the signature of SddVtreeSearchFunc, so it can be used for auto minimization
+Vtree* sdd_vtree_minimize_sift_limited(Vtree* vtree, SddManager* manager) {
+  if(vtree->some_X_constrained_vars) return sdd_vtree_minimize_limited(vtree,manager);
+  WITH_immediate_refs(manager,vtree = sdd_vtree_minimize_sift_limited_flag(vtree,manager,1));
+  return vtree;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
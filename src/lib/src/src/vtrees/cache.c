@@ -0,0 +1,447 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UNIQUE_TEMP_FILES 1
+#include <unistd.h>
+#endif
+
+//declarations
+
+//vtrees/vtree.c
+Vtree* new_leaf_vtree(SddLiteral var);
+Vtree* new_internal_vtree(Vtree* left_child, Vtree* right_child);
+void set_vtree_properties(Vtree* vtree);
+
+//vtrees/io.c
+void print_vtree(FILE* file, const Vtree* vtree);
+
+//vtrees/structured.c
+Vtree* combine_vtrees(SddSize count, Vtree** vtrees);
+void check_fnf_literals(Fnf* fnf, const char* fname);
+
+/****************************************************************************************
+ * a persistent cache of vtrees, keyed by the structure of an fnf (cnf or dnf)
+ *
+ * the structure of an fnf is its constraint graph: its vertices are the variables that
+ * appear in the fnf, and two variables are adjacent when they appear in a common clause.
+ * the fingerprint of an fnf is a hash of its vertices (and variable count) followed by
+ * a hash of its edges, both independent of the order of clauses and literals
+ *
+ * the cache is a directory holding a file <fingerprint>.vtree for each entry (in the
+ * format of sdd_vtree_save), and an index file with one line per entry: the fingerprint
+ * followed by a min-hash sketch of the vertices and edges of the constraint graph (the
+ * fraction of equal sketch values estimates the jaccard similarity of two graphs)
+ *
+ * the cache fails softly, so a compilation does not fail because of its cache: saving an
+ * entry returns 0 when the directory cannot be written, and reading an entry whose file
+ * is truncated or corrupt returns NULL. an entry is written to a temporary file which is
+ * then renamed, so readers never see a partially written entry
+ *
+ * looking up an fnf returns the entry with the same fingerprint if there is one, and
+ * otherwise the entry whose sketch is most similar (at least VTREE_CACHE_MIN_SIMILARITY).
+ * the vtree of a similar entry is adapted to the variables of the fnf:
+ *
+ * --leaves of variables beyond the variable count of the fnf are removed
+ * --a missing variable is paired with the leaf of a variable that shares a clause with
+ *   it, or is added at the top (balanced) if it shares no clause with a cached variable
+ ****************************************************************************************/
+
+#define VTREE_CACHE_INDEX "vtrees.index"
+#define FINGERPRINT_LENGTH 32 //hex digits
+
+typedef unsigned long long CacheHash;
+
+typedef struct {
+  char fingerprint[FINGERPRINT_LENGTH+1];
+  CacheHash sketch[VTREE_CACHE_SKETCH_SIZE];
+} CacheKey;
+
+/****************************************************************************************
+ * fingerprints and sketches
+ ****************************************************************************************/
+
+//a 64-bit mixing function (finalizer of splitmix64)
+static inline
+CacheHash mix(CacheHash h) {
+  h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+static
+int hash_cmp(const void* h1, const void* h2) {
+  CacheHash a = *((const CacheHash*)h1);
+  CacheHash b = *((const CacheHash*)h2);
+  return a < b? -1: a > b? 1: 0;
+}
+
+//returns the distinct vertices (var,var) and edges (u,v), u<v, of the constraint graph
+//of fnf, each encoded as (u<<32)+v (independent of the variable count), in increasing order
+static
+CacheHash* graph_elements(Fnf* fnf, SddSize* count) {
+  SddSize capacity = 0;
+  *count = 0;
+  for(SddSize i=0; i<fnf->litset_count; i++) {
+    SddLiteral size = fnf->litsets[i].literal_count;
+    capacity += size*(size+1)/2;
+  }
+  CacheHash* elements;
+  CALLOC(elements,CacheHash,capacity,"graph_elements");
+  for(SddSize i=0; i<fnf->litset_count; i++) {
+    LitSet* litset = fnf->litsets+i;
+    for(SddLiteral j=0; j<litset->literal_count; j++) {
+      CacheHash u = labs(litset->literals[j]);
+      for(SddLiteral k=j; k<litset->literal_count; k++) {
+        CacheHash v = labs(litset->literals[k]);
+        if(j==k || u!=v) elements[(*count)++] = u<v? (u<<32)+v: (v<<32)+u;
+      }
+    }
+  }
+  qsort(elements,*count,sizeof(CacheHash),hash_cmp);
+  SddSize unique = 0;
+  for(SddSize i=0; i<*count; i++) {
+    if(unique==0 || elements[i]!=elements[unique-1]) elements[unique++] = elements[i];
+  }
+  *count = unique;
+  return elements;
+}
+
+static
+void fnf_key(Fnf* fnf, CacheKey* key) {
+  CacheHash n = 1+fnf->var_count;
+  SddSize count;
+  CacheHash* elements = graph_elements(fnf,&count);
+
+  CacheHash vertices_hash = mix(n);
+  CacheHash edges_hash    = 0;
+  for(SddLiteral s=0; s<VTREE_CACHE_SKETCH_SIZE; s++) key->sketch[s] = ~0ULL;
+  for(SddSize i=0; i<count; i++) {
+    CacheHash e = elements[i];
+    if((e>>32)==(e&0xffffffffULL)) vertices_hash += mix(e);
+    else edges_hash += mix(e^0x9e3779b97f4a7c15ULL);
+    for(SddLiteral s=0; s<VTREE_CACHE_SKETCH_SIZE; s++) {
+      CacheHash h = mix(e+(s+1)*0x9e3779b97f4a7c15ULL);
+      if(h < key->sketch[s]) key->sketch[s] = h;
+    }
+  }
+  free(elements);
+
+  sprintf(key->fingerprint,"%016llx%016llx",mix(vertices_hash),mix(edges_hash));
+}
+
+//returns the fingerprint of fnf (a string of hex digits, to be freed by the caller)
+char* fnf_fingerprint(Fnf* fnf) {
+  CacheKey key;
+  fnf_key(fnf,&key);
+  char* fingerprint;
+  CALLOC(fingerprint,char,FINGERPRINT_LENGTH+1,"fnf_fingerprint");
+  strcpy(fingerprint,key.fingerprint);
+  return fingerprint;
+}
+
+/****************************************************************************************
+ * cache files
+ ****************************************************************************************/
+
+//returns the path of file name in directory (to be freed by the caller)
+static
+char* cache_path(const char* directory, const char* name, const char* extension) {
+  char* path;
+  CALLOC(path,char,strlen(directory)+strlen(name)+strlen(extension)+2,"cache_path");
+  sprintf(path,"%s/%s%s",directory,name,extension);
+  return path;
+}
+
+//reads the next key of an index file into key, returns 0 at end of file
+static
+int read_key(FILE* file, CacheKey* key) {
+  if(fscanf(file,"%32s",key->fingerprint)!=1) return 0;
+  for(SddLiteral s=0; s<VTREE_CACHE_SKETCH_SIZE; s++) {
+    if(fscanf(file,"%llx",key->sketch+s)!=1) return 0;
+  }
+  return 1;
+}
+
+static
+void write_key(FILE* file, CacheKey* key) {
+  fprintf(file,"%s",key->fingerprint);
+  for(SddLiteral s=0; s<VTREE_CACHE_SKETCH_SIZE; s++) fprintf(file," %llx",key->sketch[s]);
+  fprintf(file,"\n");
+}
+
+static
+float similarity(CacheKey* key1, CacheKey* key2) {
+  SddLiteral equal = 0;
+  for(SddLiteral s=0; s<VTREE_CACHE_SKETCH_SIZE; s++) equal += key1->sketch[s]==key2->sketch[s];
+  return ((float)equal)/VTREE_CACHE_SKETCH_SIZE;
+}
+
+//finds the entry of the index most similar to key: returns its similarity (1 for the
+//same fingerprint), or 0 if the index is empty or does not exist
+static
+float lookup_key(const char* directory, CacheKey* key, CacheKey* best) {
+  char* index_path = cache_path(directory,VTREE_CACHE_INDEX,"");
+  FILE* file = fopen(index_path,"r");
+  free(index_path);
+  if(file==NULL) return 0;
+
+  float best_similarity = 0;
+  CacheKey entry;
+  while(read_key(file,&entry)) {
+    if(strcmp(entry.fingerprint,key->fingerprint)==0) { //same fingerprint
+      best_similarity = 1;
+      *best           = entry;
+      break;
+    }
+    float s = similarity(&entry,key);
+    if(s > best_similarity) {
+      best_similarity = s;
+      *best           = entry;
+    }
+  }
+  fclose(file);
+  return best_similarity;
+}
+
+static
+void free_vtree_node(Vtree* vtree) {
+  free(vtree->search_state);
+  free(vtree);
+}
+
+//reads the next token of a vtree file into token, skipping comment lines
+//returns 0 at end of file
+static
+int read_token(FILE* file, char* token) {
+  while(fscanf(file,"%15s",token)==1) {
+    if(strcmp(token,"c")) return 1;
+    for(int c=fgetc(file); c!='\n' && c!=EOF; c=fgetc(file));
+  }
+  return 0;
+}
+
+//reads an entry in the format of sdd_vtree_save, without exiting on errors (unlike
+//sdd_vtree_read): returns NULL if the file is truncated or does not describe a vtree
+//(var counts and positions are not set)
+static
+Vtree* read_cached_vtree(FILE* file) {
+  char token[16];
+  SddLiteral node_count;
+  if(!read_token(file,token) || strcmp(token,"vtree")) return NULL;
+  if(fscanf(file,"%"PRIlitS,&node_count)!=1 || node_count<1 || node_count%2==0) return NULL;
+
+  Vtree** nodes; //nodes[position]
+  int* is_child; //is_child[position]
+  CALLOC(nodes,Vtree*,node_count,"read_cached_vtree");
+  CALLOC(is_child,int,node_count,"read_cached_vtree");
+  Vtree* vtree = NULL;
+  SddLiteral count;
+  for(count=0; count<node_count; count++) {
+    SddLiteral position, a, b;
+    if(!read_token(file,token) || strlen(token)!=1) break;
+    if(fscanf(file,"%"PRIlitS" %"PRIlitS,&position,&a)!=2) break;
+    if(position<0 || position>=node_count || nodes[position]) break;
+    if(token[0]=='L' && a>=1) nodes[position] = new_leaf_vtree(a);
+    else if(token[0]=='I' && fscanf(file,"%"PRIlitS,&b)==1 &&
+            a>=0 && a<node_count && nodes[a] && !is_child[a] &&
+            b>=0 && b<node_count && nodes[b] && !is_child[b] && a!=b) {
+      nodes[position] = new_internal_vtree(nodes[a],nodes[b]);
+      is_child[a] = is_child[b] = 1;
+    }
+    else break;
+    vtree = nodes[position]; //last node is root
+  }
+
+  if(count==node_count) { //every node but the root is the child of another
+    for(SddLiteral i=0; i<node_count; i++) if(is_child[i]==(nodes[i]==vtree)) count = 0;
+  }
+  if(count!=node_count) {
+    for(SddLiteral i=0; i<node_count; i++) if(nodes[i]) free_vtree_node(nodes[i]);
+    vtree = NULL;
+  }
+  else vtree->parent = NULL;
+  free(nodes);
+  free(is_child);
+  return vtree;
+}
+
+/****************************************************************************************
+ * adapting a cached vtree to the variables of an fnf
+ ****************************************************************************************/
+
+//removes leaves of variables larger than var_count (and leaves of repeated variables),
+//together with internal nodes left with a single child; leaves[var] is set for the
+//remaining leaves. returns NULL if all leaves were removed
+static
+Vtree* remove_extra_leaves(Vtree* vtree, SddLiteral var_count, Vtree** leaves) {
+  if(LEAF(vtree)) {
+    SddLiteral var = vtree->var;
+    if(var>=1 && var<=var_count && leaves[var]==NULL) {
+      leaves[var] = vtree;
+      return vtree;
+    }
+    free_vtree_node(vtree);
+    return NULL;
+  }
+  Vtree* left  = remove_extra_leaves(vtree->left,var_count,leaves);
+  Vtree* right = remove_extra_leaves(vtree->right,var_count,leaves);
+  if(left && right) {
+    vtree->left  = left;
+    vtree->right = right;
+    left->parent = right->parent = vtree;
+    return vtree;
+  }
+  free_vtree_node(vtree);
+  return left? left: right;
+}
+
+//replaces leaf by an internal node whose children are leaf and a new leaf for var
+static
+void pair_with_leaf(SddLiteral var, Vtree* leaf, Vtree** root, Vtree** leaves) {
+  Vtree* parent = leaf->parent;
+  leaves[var]   = new_leaf_vtree(var);
+  Vtree* pair   = new_internal_vtree(leaf,leaves[var]);
+  pair->parent  = parent;
+  if(parent==NULL) *root = pair;
+  else if(parent->left==leaf) parent->left = pair;
+  else parent->right = pair;
+}
+
+//returns a vtree over the variables 1..fnf->var_count obtained from vtree, or NULL if
+//vtree has none of these variables (vtree is consumed)
+//var counts and positions are set once, after all leaves are removed and added
+static
+Vtree* adapt_vtree(Vtree* vtree, Fnf* fnf) {
+  SddLiteral var_count = fnf->var_count;
+  Vtree** leaves;
+  CALLOC(leaves,Vtree*,1+var_count,"adapt_vtree");
+
+  Vtree* root = remove_extra_leaves(vtree,var_count,leaves);
+  if(root==NULL) {
+    free(leaves);
+    return NULL;
+  }
+  root->parent = NULL;
+
+  //pair missing variables with variables sharing a clause, until no progress is made
+  int progress = 1;
+  while(progress) {
+    progress = 0;
+    for(SddSize i=0; i<fnf->litset_count; i++) {
+      LitSet* litset = fnf->litsets+i;
+      Vtree* leaf    = NULL;
+      for(SddLiteral j=0; j<litset->literal_count && leaf==NULL; j++) leaf = leaves[labs(litset->literals[j])];
+      if(leaf) {
+        for(SddLiteral j=0; j<litset->literal_count; j++) {
+          SddLiteral var = labs(litset->literals[j]);
+          if(leaves[var]==NULL) {
+            pair_with_leaf(var,leaf,&root,leaves);
+            progress = 1;
+          }
+        }
+      }
+    }
+  }
+
+  //remaining missing variables are added at the top
+  Vtree** vtrees;
+  CALLOC(vtrees,Vtree*,1+var_count,"adapt_vtree");
+  SddLiteral count = 0;
+  vtrees[count++] = root;
+  for(SddLiteral var=1; var<=var_count; var++) if(leaves[var]==NULL) vtrees[count++] = new_leaf_vtree(var);
+  root = combine_vtrees(count,vtrees);
+  root->parent = NULL;
+  free(vtrees);
+  free(leaves);
+
+  set_vtree_properties(root);
+  return root;
+}
+
+/****************************************************************************************
+ * interface
+ ****************************************************************************************/
+
+//returns a vtree for the variables of fnf from the cache in directory: the cached vtree of
+//fnf, or the cached vtree of a similar fnf adapted to the variables of fnf
+//returns NULL if the cache has no similar entry, or if its file cannot be read
+Vtree* sdd_vtree_cache_read(const char* directory, Fnf* fnf) {
+  check_fnf_literals(fnf,"sdd_vtree_cache_read");
+  CacheKey key, best;
+  fnf_key(fnf,&key);
+  float s = lookup_key(directory,&key,&best);
+  if(s < VTREE_CACHE_MIN_SIMILARITY) return NULL;
+
+  char* path = cache_path(directory,best.fingerprint,".vtree");
+  FILE* file = fopen(path,"r");
+  free(path);
+  if(file==NULL) return NULL; //entry may have been removed from the directory
+  Vtree* vtree = read_cached_vtree(file);
+  fclose(file);
+  return vtree==NULL? NULL: adapt_vtree(vtree,fnf);
+}
+
+//saves vtree as the cache entry of fnf in directory (replacing any previous entry)
+//returns 1 if the entry was saved, 0 if the directory could not be written
+int sdd_vtree_cache_save(const char* directory, Fnf* fnf, Vtree* vtree) {
+  CacheKey key, entry;
+  fnf_key(fnf,&key);
+
+  //write to a temporary file, then rename it over the entry
+  char* path = cache_path(directory,key.fingerprint,".vtree");
+  char* temp = cache_path(directory,key.fingerprint,".vtree.XXXXXX");
+#ifdef UNIQUE_TEMP_FILES
+  int fd = mkstemp(temp);
+  FILE* file = fd<0? NULL: fdopen(fd,"w");
+  if(file==NULL && fd>=0) { close(fd); remove(temp); }
+#else
+  FILE* file = fopen(temp,"w");
+#endif
+  int written = 0;
+  if(file) {
+    print_vtree(file,vtree);
+    written = !ferror(file);
+    written = fclose(file)==0 && written && rename(temp,path)==0;
+    if(!written) remove(temp);
+  }
+  free(path);
+  free(temp);
+  if(!written) return 0;
+
+  if(lookup_key(directory,&key,&entry)==1 && strcmp(entry.fingerprint,key.fingerprint)==0) return 1; //indexed
+  char* index_path = cache_path(directory,VTREE_CACHE_INDEX,"");
+  file = fopen(index_path,"a");
+  free(index_path);
+  if(file==NULL) return 0;
+  write_key(file,&key);
+  return fclose(file)==0;
+}
+
+//the cache functions above for the cnf whose clause i has literals clauses[i][0..lengths[i]-1]
+
+Vtree* sdd_vtree_cache_read_cnf(const char* directory, SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses) {
+  Fnf fnf;
+  fnf_of_clauses(var_count,clause_count,lengths,clauses,&fnf);
+  Vtree* vtree = sdd_vtree_cache_read(directory,&fnf);
+  free(fnf.litsets);
+  return vtree;
+}
+
+int sdd_vtree_cache_save_cnf(const char* directory, SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses, Vtree* vtree) {
+  Fnf fnf;
+  fnf_of_clauses(var_count,clause_count,lengths,clauses,&fnf);
+  int saved = sdd_vtree_cache_save(directory,&fnf,vtree);
+  free(fnf.litsets);
+  return saved;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -112,6 +112,55 @@ Vtree* add_var_to_vtree(SddLiteral var, char location, Vtree* sibling, SddManage
   return leaf;
 }
 
+//constructs a balanced vtree with variables first_var, first_var+1, ..., last_var
+static
+Vtree* new_balanced_subtree(SddLiteral first_var, SddLiteral last_var) {
+  if(first_var==last_var) return new_leaf_vtree(first_var);
+  SddLiteral mid_var = first_var+(last_var-first_var)/2;
+  Vtree* left  = new_balanced_subtree(first_var,mid_var);
+  Vtree* right = new_balanced_subtree(mid_var+1,last_var);
+  return new_internal_vtree(left,right);
+}
+
+//adds a balanced vtree over variables first_var, ..., last_var (in this order)
+//if location = 'l', added vtree is to the left of sibling
+//if location = 'r', added vtree is to the right of sibling
+//returns added vtree
+//
+//the vtree is spliced in one step and the properties of the manager vtree are updated
+//once, so adding many variables this way is linear in the size of the final vtree
+
+//assumes manager has at least one variable
+Vtree* add_vars_to_vtree(SddLiteral first_var, SddLiteral last_var, char location, Vtree* sibling, SddManager* manager) {
+
+  assert(manager->var_count>0);
+  assert(first_var<=last_var);
+  assert(location=='l' || location=='r');
+
+  //save location as it will be erased by new_internal_vtree
+  char sibling_location = vtree_loc(sibling);
+  Vtree* parent = sibling->parent; //could be NULL
+
+  //construct new vtree
+  Vtree* vtree = new_balanced_subtree(first_var,last_var);
+
+  //construct new internal node (parent of sibling and new vtree)
+  Vtree* internal;
+  if(location=='l') internal = new_internal_vtree(vtree,sibling);
+  else              internal = new_internal_vtree(sibling,vtree); //location = 'r'
+
+  //replace sibling with internal as a child of parent
+  internal->parent = parent; //could be NULL
+  if(sibling_location=='R') manager->vtree = internal;
+  else if(sibling_location=='l') parent->left = internal;
+  else parent->right = internal;
+
+  //update properties to reflect new inorder and var counts (once for all variables)
+  set_vtree_properties(manager->vtree);
+
+  return vtree;
+}
+
 /****************************************************************************************
  * remove variable from vtree of manager
  ****************************************************************************************/
@@ -137,11 +186,56 @@ void remove_var_from_vtree(SddLiteral var, SddManager* manager) {
   free(leaf);
   free(parent);
   
+  //an incremental gc sweep may have stopped at a freed vtree node
+  manager->gc_step_vtree = NULL;
+  manager->gc_step_node  = NULL;
+  
   //update properties to reflect new inorder and var counts
   //CAN BE done more efficiently
   set_vtree_properties(manager->vtree);
 }
 
+//removes the leaves of vtree whose variables have keep[var]==0, together with internal
+//nodes left with a single child (which takes their place); removed nodes are freed
+//returns the remaining vtree (NULL if all leaves were removed)
+static
+Vtree* remove_leaves(Vtree* vtree, int* keep) {
+  if(LEAF(vtree)) {
+    if(keep[vtree->var]) return vtree;
+    free(vtree);
+    return NULL;
+  }
+  Vtree* left  = remove_leaves(vtree->left,keep);
+  Vtree* right = remove_leaves(vtree->right,keep);
+  if(left && right) {
+    vtree->left  = left;
+    vtree->right = right;
+    left->parent = right->parent = vtree;
+    return vtree;
+  }
+  //a node normalized for vtree mentions variables on both sides
+  assert(vtree->nodes==NULL);
+  free(vtree);
+  return left? left: right;
+}
+
+//removes the variables with keep[var]==0 from the vtree of manager, in one pass
+//assumes at least one variable is kept and no removed variable is used
+void remove_vars_from_vtree(int* keep, SddManager* manager) {
+
+  Vtree* vtree = remove_leaves(manager->vtree,keep);
+  assert(vtree!=NULL);
+  vtree->parent  = NULL;
+  manager->vtree = vtree;
+
+  //an incremental gc sweep may have stopped at a freed vtree node
+  manager->gc_step_vtree = NULL;
+  manager->gc_step_node  = NULL;
+
+  //update properties to reflect new inorder and var counts (once for all variables)
+  set_vtree_properties(manager->vtree);
+}
+
 /****************************************************************************************
  * move variable in vtree of manager
  ****************************************************************************************/
@@ -0,0 +1,584 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "sdd.h"
+
+//declarations
+
+//vtrees/vtree.c
+Vtree* new_leaf_vtree(SddLiteral var);
+Vtree* new_internal_vtree(Vtree* left_child, Vtree* right_child);
+void set_vtree_properties(Vtree* vtree);
+
+//local declarations
+static Vtree* vtree_from_elimination_order(Fnf* fnf, int min_fill);
+static Vtree* vtree_from_dtree(Fnf* fnf);
+
+/****************************************************************************************
+ * constructing vtrees from the structure of an fnf (cnf or dnf)
+ *
+ * "min-fill", "min-degree": a variable elimination order is computed greedily on the
+ * primal graph (variables are adjacent when they appear in a common clause). variables
+ * are then eliminated in that order, maintaining a vtree for each group of clauses that
+ * share eliminated variables: eliminating x merges the groups of its clauses, combining
+ * their vtrees (balanced) as the right child of a node whose left child is x. for a
+ * chain, this yields a right-linear vtree whose order is the reverse elimination order
+ *
+ * "dtree": the clauses are bisected recursively (incidence hypergraph). each bisection
+ * orders clauses by a breadth-first traversal over shared variables and splits the
+ * order where the fewest variables are shared by both sides (cutset). cutset variables
+ * are placed on a right-linear spine above the vtrees of the two sides
+ *
+ * variables not in any clause are added at the top (balanced)
+ ****************************************************************************************/
+
+//exits unless every literal of fnf is a literal of a variable in 1..fnf->var_count
+//also used by vtrees/cache.c
+void check_fnf_literals(Fnf* fnf, const char* fname) {
+  for(SddSize i=0; i<fnf->litset_count; i++) {
+    LitSet* litset = fnf->litsets+i;
+    for(SddLiteral j=0; j<litset->literal_count; j++) {
+      SddLiteral lit = litset->literals[j];
+      CHECK_ERROR(lit==0 || labs(lit)>fnf->var_count,ERR_MSG_INVALID_VAR,fname);
+    }
+  }
+}
+
+//returns a vtree for the variables of fnf
+//method is "min-fill", "min-degree" or "dtree"
+Vtree* sdd_vtree_new_from_fnf(Fnf* fnf, const char* method) {
+  CHECK_ERROR(fnf->var_count<1,ERR_MSG_VTREE,"sdd_vtree_new_from_fnf");
+  check_fnf_literals(fnf,"sdd_vtree_new_from_fnf");
+  Vtree* vtree = NULL;
+  if(strcmp(method,"min-fill")==0) vtree = vtree_from_elimination_order(fnf,1);
+  else if(strcmp(method,"min-degree")==0) vtree = vtree_from_elimination_order(fnf,0);
+  else if(strcmp(method,"dtree")==0) vtree = vtree_from_dtree(fnf);
+  CHECK_ERROR(vtree==NULL,ERR_MSG_VTREE,"sdd_vtree_new_from_fnf");
+  set_vtree_properties(vtree);
+  return vtree;
+}
+
+//sets fnf to the cnf whose clause i has literals clauses[i][0..lengths[i]-1]
+//the literals are shared with clauses: only fnf->litsets is allocated (freed by the caller)
+void fnf_of_clauses(SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses, Fnf* fnf) {
+  fnf->var_count    = var_count;
+  fnf->litset_count = clause_count;
+  fnf->op           = CONJOIN;
+  CALLOC(fnf->litsets,LitSet,clause_count,"fnf_of_clauses");
+  for(SddSize i=0; i<clause_count; i++) {
+    LitSet* litset        = fnf->litsets+i;
+    litset->id            = i;
+    litset->literal_count = lengths[i];
+    litset->literals      = clauses[i];
+    litset->op            = DISJOIN;
+  }
+}
+
+//returns a vtree for the variables of the cnf whose clause i has literals
+//clauses[i][0..lengths[i]-1] (see sdd_vtree_new_from_fnf for method)
+Vtree* sdd_vtree_new_from_cnf(SddLiteral var_count, SddSize clause_count, SddLiteral* lengths, SddLiteral** clauses, const char* method) {
+  Fnf fnf;
+  fnf_of_clauses(var_count,clause_count,lengths,clauses,&fnf);
+  Vtree* vtree = sdd_vtree_new_from_fnf(&fnf,method);
+  free(fnf.litsets);
+  return vtree;
+}
+
+//balanced vtree over vtrees[0..count-1] (NULL if count is 0)
+//also used by vtrees/cache.c
+Vtree* combine_vtrees(SddSize count, Vtree** vtrees) {
+  if(count==0) return NULL;
+  if(count==1) return vtrees[0];
+  SddSize mid = count/2;
+  Vtree* left  = combine_vtrees(mid,vtrees);
+  Vtree* right = combine_vtrees(count-mid,vtrees+mid);
+  return new_internal_vtree(left,right);
+}
+
+//adds variables that appear in no clause (seen[var]==0) at the top of vtree
+static
+Vtree* add_unused_vars(Vtree* vtree, char* seen, SddLiteral var_count) {
+  Vtree** vtrees;
+  CALLOC(vtrees,Vtree*,1+var_count,"add_unused_vars");
+  SddSize count = 0;
+  if(vtree) vtrees[count++] = vtree;
+  for(SddLiteral var=1; var<=var_count; var++) if(!seen[var]) vtrees[count++] = new_leaf_vtree(var);
+  vtree = combine_vtrees(count,vtrees);
+  free(vtrees);
+  return vtree;
+}
+
+/****************************************************************************************
+ * primal graph and elimination orders
+ ****************************************************************************************/
+
+typedef struct {
+  SddLiteral var_count;
+  SddLiteral** adj; //adj[var]: neighbors of var that are not eliminated
+  SddLiteral* degree;
+  SddLiteral* capacity;
+  SddSize* mark; //for fill computation
+  SddSize stamp;
+} Graph;
+
+static
+int has_edge(SddLiteral u, SddLiteral v, Graph* g) {
+  for(SddLiteral i=0; i<g->degree[u]; i++) if(g->adj[u][i]==v) return 1;
+  return 0;
+}
+
+static
+void add_arc(SddLiteral u, SddLiteral v, Graph* g) {
+  if(g->degree[u]==g->capacity[u]) {
+    g->capacity[u] = 2*g->capacity[u]+4;
+    REALLOC(g->adj[u],SddLiteral,g->capacity[u],"add_arc");
+  }
+  g->adj[u][g->degree[u]++] = v;
+}
+
+static
+void add_edge(SddLiteral u, SddLiteral v, Graph* g) {
+  if(u==v || has_edge(u,v,g)) return;
+  add_arc(u,v,g);
+  add_arc(v,u,g);
+}
+
+static
+void remove_arc(SddLiteral u, SddLiteral v, Graph* g) {
+  for(SddLiteral i=0; i<g->degree[u]; i++) {
+    if(g->adj[u][i]==v) {
+      g->adj[u][i] = g->adj[u][--g->degree[u]];
+      return;
+    }
+  }
+}
+
+//number of edges to add between neighbors of var if var is eliminated
+static
+SddSize fill_of(SddLiteral var, Graph* g) {
+  SddLiteral d = g->degree[var];
+  ++g->stamp;
+  for(SddLiteral i=0; i<d; i++) g->mark[g->adj[var][i]] = g->stamp;
+  SddSize arcs = 0; //arcs between neighbors (each edge counted twice)
+  for(SddLiteral i=0; i<d; i++) {
+    SddLiteral u = g->adj[var][i];
+    for(SddLiteral j=0; j<g->degree[u]; j++) arcs += g->mark[g->adj[u][j]]==g->stamp;
+  }
+  return d*(d-1)/2 - arcs/2;
+}
+
+/****************************************************************************************
+ * binary heap of variables that are not eliminated, ordered by score, then degree, then
+ * index (the first variable of a linear scan in the same order)
+ ****************************************************************************************/
+
+typedef struct {
+  SddLiteral count;
+  SddLiteral* vars; //vars[0..count-1]
+  SddLiteral* position; //position[var]: index of var in vars
+  SddSize* score;
+  SddLiteral* degree;
+} VarHeap;
+
+static
+int heap_precedes(SddLiteral u, SddLiteral v, VarHeap* h) {
+  if(h->score[u]!=h->score[v]) return h->score[u] < h->score[v];
+  if(h->degree[u]!=h->degree[v]) return h->degree[u] < h->degree[v];
+  return u < v;
+}
+
+static
+void heap_place(SddLiteral var, SddLiteral i, VarHeap* h) {
+  h->vars[i]       = var;
+  h->position[var] = i;
+}
+
+//var may have to move up or down after its score or degree changed
+static
+void heap_update(SddLiteral var, VarHeap* h) {
+  SddLiteral i = h->position[var];
+  while(i>0 && heap_precedes(var,h->vars[(i-1)/2],h)) { //up
+    heap_place(h->vars[(i-1)/2],i,h);
+    i = (i-1)/2;
+  }
+  for(;;) { //down
+    SddLiteral c = 2*i+1;
+    if(c>=h->count) break;
+    if(c+1<h->count && heap_precedes(h->vars[c+1],h->vars[c],h)) ++c;
+    if(!heap_precedes(h->vars[c],var,h)) break;
+    heap_place(h->vars[c],i,h);
+    i = c;
+  }
+  heap_place(var,i,h);
+}
+
+static
+SddLiteral heap_pop(VarHeap* h) {
+  SddLiteral top  = h->vars[0];
+  SddLiteral last = h->vars[--h->count];
+  if(h->count) {
+    heap_place(last,0,h);
+    heap_update(last,h);
+  }
+  return top;
+}
+
+//returns an elimination order of all variables (array of size var_count)
+static
+SddLiteral* elimination_order(Fnf* fnf, int min_fill) {
+  SddLiteral n = fnf->var_count;
+  assert(n>0);
+  Graph g;
+  g.var_count = n;
+  g.stamp     = 0;
+  CALLOC(g.adj,SddLiteral*,1+n,"elimination_order");
+  CALLOC(g.degree,SddLiteral,1+n,"elimination_order");
+  CALLOC(g.capacity,SddLiteral,1+n,"elimination_order");
+  CALLOC(g.mark,SddSize,1+n,"elimination_order");
+
+  for(SddSize c=0; c<fnf->litset_count; c++) {
+    LitSet* clause = fnf->litsets+c;
+    for(SddLiteral i=0; i<clause->literal_count; i++) {
+      for(SddLiteral j=i+1; j<clause->literal_count; j++) {
+        add_edge(labs(clause->literals[i]),labs(clause->literals[j]),&g);
+      }
+    }
+  }
+
+  SddSize* score;
+  VarHeap heap;
+  CALLOC(score,SddSize,1+n,"elimination_order");
+  CALLOC(heap.vars,SddLiteral,n,"elimination_order");
+  CALLOC(heap.position,SddLiteral,1+n,"elimination_order");
+  heap.count  = 0;
+  heap.score  = score;
+  heap.degree = g.degree;
+  for(SddLiteral var=1; var<=n; var++) {
+    score[var] = min_fill? fill_of(var,&g): (SddSize)g.degree[var];
+    heap_place(var,heap.count++,&heap);
+    heap_update(var,&heap);
+  }
+
+  SddLiteral* order;
+  CALLOC(order,SddLiteral,n,"elimination_order");
+  for(SddLiteral k=0; k<n; k++) {
+    SddLiteral x = heap_pop(&heap); //next variable: smallest score, then smallest degree
+    order[k] = x;
+
+    //connect the neighbors of x, then remove x
+    SddLiteral d = g.degree[x];
+    SddLiteral* neighbors = g.adj[x];
+    for(SddLiteral i=0; i<d; i++) {
+      for(SddLiteral j=i+1; j<d; j++) add_edge(neighbors[i],neighbors[j],&g);
+    }
+    for(SddLiteral i=0; i<d; i++) remove_arc(neighbors[i],x,&g);
+
+    //update scores of affected variables (only neighbors of x change degree)
+    if(min_fill) { //neighbors of x and their neighbors
+      for(SddLiteral i=0; i<d; i++) {
+        SddLiteral u = neighbors[i];
+        score[u] = fill_of(u,&g);
+        heap_update(u,&heap);
+        for(SddLiteral j=0; j<g.degree[u]; j++) {
+          SddLiteral v = g.adj[u][j];
+          score[v] = fill_of(v,&g);
+          heap_update(v,&heap);
+        }
+      }
+    }
+    else {
+      for(SddLiteral i=0; i<d; i++) {
+        score[neighbors[i]] = g.degree[neighbors[i]];
+        heap_update(neighbors[i],&heap);
+      }
+    }
+  }
+
+  for(SddLiteral var=1; var<=n; var++) free(g.adj[var]);
+  free(g.adj);
+  free(g.degree);
+  free(g.capacity);
+  free(g.mark);
+  free(score);
+  free(heap.vars);
+  free(heap.position);
+  return order;
+}
+
+/****************************************************************************************
+ * vtree from elimination order
+ ****************************************************************************************/
+
+//union-find over clauses: root clauses hold the vtree of their group
+static
+SddSize find_group(SddSize c, SddSize* parent) {
+  while(parent[c]!=c) c = parent[c] = parent[parent[c]];
+  return c;
+}
+
+static
+Vtree* vtree_from_elimination_order(Fnf* fnf, int min_fill) {
+  SddLiteral n   = fnf->var_count;
+  SddSize cc     = fnf->litset_count;
+  assert(n>0); //checked by sdd_vtree_new_from_fnf
+  size_t group_count = cc+(size_t)n; //at most one vtree per clause and per variable
+  SddLiteral* order = elimination_order(fnf,min_fill);
+
+  //clauses of each variable
+  SddSize* occ_count;
+  SddSize** occs;
+  CALLOC(occ_count,SddSize,1+n,"vtree_from_elimination_order");
+  CALLOC(occs,SddSize*,1+n,"vtree_from_elimination_order");
+  for(SddSize c=0; c<cc; c++) {
+    LitSet* clause = fnf->litsets+c;
+    for(SddLiteral i=0; i<clause->literal_count; i++) ++occ_count[labs(clause->literals[i])];
+  }
+  for(SddLiteral var=1; var<=n; var++) {
+    CALLOC(occs[var],SddSize,occ_count[var],"vtree_from_elimination_order");
+    occ_count[var] = 0;
+  }
+  for(SddSize c=0; c<cc; c++) {
+    LitSet* clause = fnf->litsets+c;
+    for(SddLiteral i=0; i<clause->literal_count; i++) {
+      SddLiteral var = labs(clause->literals[i]);
+      occs[var][occ_count[var]++] = c;
+    }
+  }
+
+  SddSize* parent;
+  Vtree** group_vtree;
+  char* seen;
+  Vtree** vtrees;
+  CALLOC(parent,SddSize,cc,"vtree_from_elimination_order");
+  CALLOC(group_vtree,Vtree*,cc,"vtree_from_elimination_order");
+  CALLOC(seen,char,1+n,"vtree_from_elimination_order");
+  CALLOC(vtrees,Vtree*,group_count,"vtree_from_elimination_order");
+  for(SddSize c=0; c<cc; c++) parent[c] = c;
+
+  for(SddLiteral k=0; k<n; k++) {
+    SddLiteral x = order[k];
+    if(occ_count[x]==0) continue; //added at the top
+    seen[x] = 1;
+    //collect and merge the groups of the clauses of x
+    SddSize count = 0;
+    SddSize root  = find_group(occs[x][0],parent);
+    for(SddSize i=0; i<occ_count[x]; i++) {
+      SddSize r = find_group(occs[x][i],parent);
+      if(group_vtree[r]) {
+        vtrees[count++] = group_vtree[r];
+        group_vtree[r]  = NULL;
+      }
+      parent[r] = root;
+    }
+    parent[root] = root;
+    Vtree* combined = combine_vtrees(count,vtrees);
+    Vtree* leaf     = new_leaf_vtree(x);
+    group_vtree[root] = combined? new_internal_vtree(leaf,combined): leaf;
+  }
+
+  //combine the groups (connected components)
+  SddSize count = 0;
+  for(SddSize c=0; c<cc; c++) if(group_vtree[c]) vtrees[count++] = group_vtree[c];
+  Vtree* vtree = add_unused_vars(combine_vtrees(count,vtrees),seen,n);
+
+  for(SddLiteral var=1; var<=n; var++) free(occs[var]);
+  free(occs);
+  free(occ_count);
+  free(order);
+  free(parent);
+  free(group_vtree);
+  free(seen);
+  free(vtrees);
+  return vtree;
+}
+
+/****************************************************************************************
+ * vtree from dtree (recursive bisection of clauses)
+ ****************************************************************************************/
+
+typedef struct {
+  Fnf* fnf;
+  SddSize** occs; //occs[var]: clauses of var
+  SddSize* occ_count;
+  char* placed; //placed[var]: var is in the vtree already
+  SddSize* in_set; //in_set[c]==stamp: clause c is in the current set
+  SddSize* visited;
+  SddSize* first; //first[var], last[var]: positions of var in the clause order
+  SddSize* last;
+  SddSize* var_stamp;
+  SddSize stamp;
+  SddSize* queue;
+  SddLiteral* vars;
+} Dtree;
+
+//orders clauses[0..count-1] by breadth-first traversals over shared (unplaced) variables
+//the second traversal starts from the last clause reached by the first (peripheral)
+static
+void order_clauses(SddSize* clauses, SddSize count, Dtree* d) {
+  SddSize set_stamp = ++d->stamp;
+  for(SddSize i=0; i<count; i++) d->in_set[clauses[i]] = set_stamp;
+  SddSize* queue = d->queue;
+  SddSize start  = clauses[0];
+  for(int pass=0; pass<2; pass++) {
+    SddSize visit_stamp = ++d->stamp;
+    SddSize head = 0, tail = 0;
+    for(SddSize s=0; s<=count; s++) { //one traversal per connected component
+      SddSize c = s==0? start: clauses[s-1];
+      if(d->visited[c]==visit_stamp) continue;
+      d->visited[c] = visit_stamp;
+      queue[tail++] = c;
+      while(head<tail) {
+        LitSet* clause = d->fnf->litsets+queue[head++];
+        for(SddLiteral i=0; i<clause->literal_count; i++) {
+          SddLiteral var = labs(clause->literals[i]);
+          if(d->placed[var]) continue;
+          for(SddSize j=0; j<d->occ_count[var]; j++) {
+            SddSize o = d->occs[var][j];
+            if(d->in_set[o]!=set_stamp || d->visited[o]==visit_stamp) continue;
+            d->visited[o] = visit_stamp;
+            queue[tail++] = o;
+          }
+        }
+      }
+    }
+    assert(tail==count);
+    start = queue[tail-1];
+  }
+  memcpy(clauses,queue,count*sizeof(SddSize));
+}
+
+static
+Vtree* dtree_vtree(SddSize* clauses, SddSize count, Dtree* d) {
+  SddLiteral var_count = 0;
+  if(count==1) { //leaf: variables of clause not placed yet
+    LitSet* clause = d->fnf->litsets+clauses[0];
+    Vtree** vtrees;
+    CALLOC(vtrees,Vtree*,clause->literal_count,"dtree_vtree");
+    for(SddLiteral i=0; i<clause->literal_count; i++) {
+      SddLiteral var = labs(clause->literals[i]);
+      if(d->placed[var]) continue;
+      d->placed[var] = 1;
+      vtrees[var_count++] = new_leaf_vtree(var);
+    }
+    Vtree* vtree = combine_vtrees(var_count,vtrees);
+    free(vtrees);
+    return vtree;
+  }
+
+  order_clauses(clauses,count,d);
+
+  //first and last positions of unplaced variables in the order
+  ++d->stamp;
+  SddLiteral* vars = d->vars;
+  for(SddSize p=0; p<count; p++) {
+    LitSet* clause = d->fnf->litsets+clauses[p];
+    for(SddLiteral i=0; i<clause->literal_count; i++) {
+      SddLiteral var = labs(clause->literals[i]);
+      if(d->placed[var]) continue;
+      if(d->var_stamp[var]!=d->stamp) {
+        d->var_stamp[var] = d->stamp;
+        d->first[var]     = p;
+        vars[var_count++] = var;
+      }
+      d->last[var] = p;
+    }
+  }
+
+  //cut[k]: number of variables in both clauses[0..k-1] and clauses[k..count-1]
+  SddSize* cut;
+  CALLOC(cut,SddSize,count+1,"dtree_vtree");
+  for(SddLiteral i=0; i<var_count; i++) {
+    ++cut[d->first[vars[i]]+1];
+    --cut[d->last[vars[i]]+1];
+  }
+  for(SddSize k=1; k<=count; k++) cut[k] += cut[k-1];
+  SddSize lo = MAX(1,count/3);
+  SddSize hi = MAX(lo,MIN(count-1,(2*count)/3));
+  SddSize split = lo;
+  for(SddSize k=lo; k<=hi; k++) {
+    if(cut[k]<cut[split] || (cut[k]==cut[split] && labs((long)(2*k)-(long)count)<labs((long)(2*split)-(long)count))) split = k;
+  }
+  free(cut);
+
+  //cutset: placed above the two sides
+  SddLiteral cutset_count = 0;
+  SddLiteral* cutset;
+  CALLOC(cutset,SddLiteral,var_count,"dtree_vtree");
+  for(SddLiteral i=0; i<var_count; i++) {
+    SddLiteral var = vars[i];
+    if(d->first[var]<split && split<=d->last[var]) cutset[cutset_count++] = var;
+  }
+  for(SddLiteral i=0; i<cutset_count; i++) d->placed[cutset[i]] = 1;
+
+  Vtree* left  = dtree_vtree(clauses,split,d);
+  Vtree* right = dtree_vtree(clauses+split,count-split,d);
+  Vtree* vtree = left==NULL? right: right==NULL? left: new_internal_vtree(left,right);
+  for(SddLiteral i=cutset_count-1; i>=0; i--) {
+    Vtree* leaf = new_leaf_vtree(cutset[i]);
+    vtree = vtree? new_internal_vtree(leaf,vtree): leaf;
+  }
+  free(cutset);
+  return vtree;
+}
+
+static
+Vtree* vtree_from_dtree(Fnf* fnf) {
+  SddLiteral n = fnf->var_count;
+  SddSize cc   = fnf->litset_count;
+
+  Dtree d;
+  d.fnf   = fnf;
+  d.stamp = 0;
+  CALLOC(d.occ_count,SddSize,1+n,"vtree_from_dtree");
+  CALLOC(d.occs,SddSize*,1+n,"vtree_from_dtree");
+  CALLOC(d.placed,char,1+n,"vtree_from_dtree");
+  CALLOC(d.in_set,SddSize,cc,"vtree_from_dtree");
+  CALLOC(d.visited,SddSize,cc,"vtree_from_dtree");
+  CALLOC(d.first,SddSize,1+n,"vtree_from_dtree");
+  CALLOC(d.last,SddSize,1+n,"vtree_from_dtree");
+  CALLOC(d.var_stamp,SddSize,1+n,"vtree_from_dtree");
+  CALLOC(d.queue,SddSize,cc,"vtree_from_dtree");
+  CALLOC(d.vars,SddLiteral,n,"vtree_from_dtree");
+  for(SddSize c=0; c<cc; c++) {
+    LitSet* clause = fnf->litsets+c;
+    for(SddLiteral i=0; i<clause->literal_count; i++) ++d.occ_count[labs(clause->literals[i])];
+  }
+  for(SddLiteral var=1; var<=n; var++) {
+    CALLOC(d.occs[var],SddSize,d.occ_count[var],"vtree_from_dtree");
+    d.occ_count[var] = 0;
+  }
+  for(SddSize c=0; c<cc; c++) {
+    LitSet* clause = fnf->litsets+c;
+    for(SddLiteral i=0; i<clause->literal_count; i++) {
+      SddLiteral var = labs(clause->literals[i]);
+      d.occs[var][d.occ_count[var]++] = c;
+    }
+  }
+
+  SddSize* clauses;
+  CALLOC(clauses,SddSize,cc,"vtree_from_dtree");
+  for(SddSize c=0; c<cc; c++) clauses[c] = c;
+  Vtree* vtree = cc? dtree_vtree(clauses,cc,&d): NULL;
+  vtree = add_unused_vars(vtree,d.placed,n);
+
+  for(SddLiteral var=1; var<=n; var++) free(d.occs[var]);
+  free(d.occs);
+  free(d.occ_count);
+  free(d.placed);
+  free(d.in_set);
+  free(d.visited);
+  free(d.first);
+  free(d.last);
+  free(d.var_stamp);
+  free(d.queue);
+  free(d.vars);
+  free(clauses);
+  return vtree;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -30,6 +30,7 @@
   vtree->user_data         = NULL;\
   vtree->user_search_state = NULL;\
   vtree->user_bit          = 0;\
+  vtree->spilled           = 0;\
   /* auto minimize mode */\
   vtree->auto_last_search_live_size = 0;\
   /* vtree search state (library)*/\
@@ -0,0 +1,54 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "../test.h"
+
+/****************************************************************************************
+ * auto search policies (sdd_manager_set_auto_search_policy)
+ *
+ * compiles the same random 3-cnfs with auto minimization, under the fixed ('f') and
+ * adaptive ('g') growth policies, and reports the compile time (including searches) and
+ * the final live size. the adaptive policy searches less when searches achieve little or
+ * take most of the time, so it is expected to be faster, possibly with larger sizes
+ *
+ * usage: bench_auto [var-count] [cnf-count]
+ ****************************************************************************************/
+
+int main(int argc, char** argv) {
+  SddLiteral var_count = argc > 1? atol(argv[1]): 40;
+  int cnf_count        = argc > 2? atoi(argv[2]): 8;
+  SddSize clause_count = (SddSize) (2.5*var_count);
+  if(clause_count > TEST_MAX_CLAUSES) clause_count = TEST_MAX_CLAUSES;
+
+  TestCnf* cnfs;
+  CHECK((cnfs = calloc(cnf_count,sizeof(TestCnf)))!=NULL);
+  for(int i=0; i<cnf_count; i++) random_cnf(var_count,clause_count,3,cnfs+i);
+
+  printf("%d cnfs, %ld vars, %zu clauses\n",cnf_count,var_count,clause_count);
+  const char policies[] = { 'f', 'g' };
+  for(int p=0; p<2; p++) {
+    double seconds = 0;
+    SddSize size   = 0;
+    for(int i=0; i<cnf_count; i++) {
+      SddManager* manager = sdd_manager_create(var_count,1);
+      sdd_manager_set_auto_search_policy(policies[p],manager);
+      clock_t start = clock();
+      SddNode* node = compile_cnf(cnfs+i,manager);
+      seconds += seconds_since(start);
+      size    += sdd_manager_live_size(manager);
+      sdd_deref(node,manager);
+      sdd_manager_free(manager);
+    }
+    printf("policy '%c': %.3fs, size %zu\n",policies[p],seconds,size);
+  }
+
+  free(cnfs);
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
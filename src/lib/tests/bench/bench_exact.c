@@ -0,0 +1,58 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "../test.h"
+
+/****************************************************************************************
+ * exact window search (sdd_manager_set_vtree_search_exact_window)
+ *
+ * compiles random 3-cnfs without minimization, then minimizes each of them with local
+ * search (sdd_manager_minimize) under each window size, and reports the minimization
+ * time and the final live size. window size 0 is local search alone (the default); the
+ * exact pass only runs after local search converges, so larger windows can only reduce
+ * the size found by local search, at the cost of the extra time reported
+ *
+ * usage: bench_exact [var-count] [cnf-count]
+ ****************************************************************************************/
+
+int main(int argc, char** argv) {
+  SddLiteral var_count = argc > 1? atol(argv[1]): 40;
+  int cnf_count        = argc > 2? atoi(argv[2]): 8;
+  SddSize clause_count = (SddSize) (2.5*var_count);
+  if(clause_count > TEST_MAX_CLAUSES) clause_count = TEST_MAX_CLAUSES;
+
+  TestCnf* cnfs;
+  CHECK((cnfs = calloc(cnf_count,sizeof(TestCnf)))!=NULL);
+  for(int i=0; i<cnf_count; i++) random_cnf(var_count,clause_count,3,cnfs+i);
+
+  printf("%d cnfs, %ld vars, %zu clauses\n",cnf_count,var_count,clause_count);
+  SddLiteral windows[] = { 0, 4, 6, 8 };
+  for(int w=0; w<4; w++) {
+    double seconds = 0;
+    SddSize size   = 0;
+    for(int i=0; i<cnf_count; i++) {
+      Vtree* vtree = sdd_vtree_new(var_count,"balanced");
+      SddManager* manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+      sdd_manager_set_vtree_search_exact_window(windows[w],manager);
+      SddNode* node = compile_cnf(&cnfs[i],manager);
+      clock_t start = clock();
+      sdd_manager_minimize(manager);
+      seconds += seconds_since(start);
+      size    += sdd_manager_live_size(manager);
+      sdd_deref(node,manager);
+      sdd_manager_free(manager);
+    }
+    printf("exact window %ld: %.3fs, size %zu\n",windows[w],seconds,size);
+  }
+
+  free(cnfs);
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
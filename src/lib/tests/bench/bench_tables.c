@@ -0,0 +1,55 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "../test.h"
+
+/****************************************************************************************
+ * placement of large tables (sdd_manager_set_huge_pages)
+ *
+ * compiles the same random 3-cnfs without minimization, under each huge page mode, and
+ * reports the compile time and the number of nodes. the unique table, the computed caches
+ * and the node slabs are the tables affected. the benefit depends on the system: mode 2
+ * needs huge pages reserved (e.g., /proc/sys/vm/nr_hugepages), otherwise it behaves
+ * like mode 1, and mode 1 needs transparent huge pages enabled in madvise mode
+ *
+ * usage: bench_tables [var-count] [cnf-count]
+ ****************************************************************************************/
+
+int main(int argc, char** argv) {
+  SddLiteral var_count = argc > 1? atol(argv[1]): 60;
+  int cnf_count        = argc > 2? atoi(argv[2]): 8;
+  SddSize clause_count = (SddSize) (2.5*var_count);
+  if(clause_count > TEST_MAX_CLAUSES) clause_count = TEST_MAX_CLAUSES;
+
+  TestCnf* cnfs;
+  CHECK((cnfs = calloc(cnf_count,sizeof(TestCnf)))!=NULL);
+  for(int i=0; i<cnf_count; i++) random_cnf(var_count,clause_count,3,cnfs+i);
+
+  printf("%d cnfs, %ld vars, %zu clauses\n",cnf_count,var_count,clause_count);
+  for(int mode=0; mode<=2; mode++) {
+    double seconds = 0;
+    SddSize nodes  = 0;
+    for(int i=0; i<cnf_count; i++) {
+      Vtree* vtree = sdd_vtree_new(var_count,"balanced");
+      SddManager* manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+      sdd_manager_set_huge_pages(mode,manager);
+      clock_t start = clock();
+      compile_cnf(cnfs+i,manager);
+      seconds += seconds_since(start);
+      nodes   += sdd_manager_count(manager);
+      sdd_manager_free(manager);
+    }
+    printf("huge pages mode %d: %.3fs, %zu nodes\n",mode,seconds,nodes);
+  }
+
+  free(cnfs);
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,136 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#ifndef SDD_TEST_H_
+#define SDD_TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sdd/sdd.h"
+
+/****************************************************************************************
+ * helpers shared by tests and benchmarks
+ *
+ * functions are checked against brute force on small inputs: an assignment of vars
+ * 1..n is an unsigned long whose bit var-1 is the value of var
+ ****************************************************************************************/
+
+#define CHECK(C) do {\
+  if(!(C)) {\
+    fprintf(stderr,"%s:%d: check failed: %s\n",__FILE__,__LINE__,#C);\
+    exit(1);\
+  }\
+} while(0)
+
+typedef unsigned long Assignment;
+
+//xorshift: tests are reproducible
+static unsigned long long test_seed = 88172645463325252ULL;
+
+static inline
+unsigned test_random(void) {
+  test_seed ^= test_seed << 13;
+  test_seed ^= test_seed >> 7;
+  test_seed ^= test_seed << 17;
+  return (unsigned) (test_seed >> 11);
+}
+
+static inline
+int value_of(SddLiteral var, Assignment a) {
+  return (a >> (var-1)) & 1;
+}
+
+//value of node under a
+static inline int eval_sdd(SddNode* node, Assignment a) {
+  if(sdd_node_is_true(node)) return 1;
+  if(sdd_node_is_false(node)) return 0;
+  if(sdd_node_is_literal(node)) {
+    SddLiteral literal = sdd_node_literal(node);
+    int value = value_of(labs(literal),a);
+    return literal > 0? value: !value;
+  }
+  SddNode** elements = sdd_node_elements(node);
+  for(SddNodeSize i=0; i<sdd_node_size(node); i++) {
+    if(eval_sdd(elements[2*i],a)) return eval_sdd(elements[2*i+1],a);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * cnfs
+ ****************************************************************************************/
+
+#define TEST_MAX_CLAUSES 512
+#define TEST_MAX_CLAUSE_LENGTH 4
+
+typedef struct {
+  SddLiteral var_count;
+  SddSize clause_count;
+  SddLiteral lengths[TEST_MAX_CLAUSES];
+  SddLiteral literals[TEST_MAX_CLAUSES][TEST_MAX_CLAUSE_LENGTH];
+} TestCnf;
+
+static inline void random_cnf(SddLiteral var_count, SddSize clause_count, SddLiteral length, TestCnf* cnf) {
+  cnf->var_count    = var_count;
+  cnf->clause_count = clause_count;
+  for(SddSize i=0; i<clause_count; i++) {
+    cnf->lengths[i] = length;
+    for(SddLiteral j=0; j<length; j++) {
+      SddLiteral var = 1+test_random()%var_count;
+      cnf->literals[i][j] = test_random()%2? var: -var;
+    }
+  }
+}
+
+static inline int eval_cnf(TestCnf* cnf, Assignment a) {
+  for(SddSize i=0; i<cnf->clause_count; i++) {
+    int sat = 0;
+    for(SddLiteral j=0; j<cnf->lengths[i] && !sat; j++) {
+      SddLiteral literal = cnf->literals[i][j];
+      sat = literal > 0? value_of(literal,a): !value_of(-literal,a);
+    }
+    if(!sat) return 0;
+  }
+  return 1;
+}
+
+//returns a referenced sdd for cnf
+static inline SddNode* compile_cnf(TestCnf* cnf, SddManager* manager) {
+  SddNode* node = sdd_ref(sdd_manager_true(manager),manager);
+  for(SddSize i=0; i<cnf->clause_count; i++) {
+    SddNode* clause = sdd_ref(sdd_manager_false(manager),manager);
+    for(SddLiteral j=0; j<cnf->lengths[i]; j++) {
+      SddNode* next = sdd_ref(sdd_disjoin(clause,sdd_manager_literal(cnf->literals[i][j],manager),manager),manager);
+      sdd_deref(clause,manager);
+      clause = next;
+    }
+    SddNode* next = sdd_ref(sdd_conjoin(node,clause,manager),manager);
+    sdd_deref(node,manager);
+    sdd_deref(clause,manager);
+    node = next;
+  }
+  return node;
+}
+
+//node agrees with cnf on all assignments of vars 1..cnf->var_count
+static inline int same_as_cnf(SddNode* node, TestCnf* cnf) {
+  for(Assignment a=0; a < (1UL << cnf->var_count); a++) {
+    if(eval_sdd(node,a)!=eval_cnf(cnf,a)) return 0;
+  }
+  return 1;
+}
+
+static inline double seconds_since(clock_t start) {
+  return ((double)(clock()-start))/CLOCKS_PER_SEC;
+}
+
+#endif // SDD_TEST_H_
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
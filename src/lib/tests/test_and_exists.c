@@ -0,0 +1,78 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * relational product: exists vars in map: node1 and node2
+ *
+ * the cache of the manager is kept across calls: results for one map must not be
+ * returned for another, or after a compaction
+ ****************************************************************************************/
+
+#define VAR_COUNT 10
+
+static void check_cache_contexts(void) {
+  SddManager* manager = sdd_manager_create(3,0);
+  SddNode* x[4];
+  for(SddLiteral var=1; var<=3; var++) x[var] = sdd_manager_literal(var,manager);
+  SddNode* f = sdd_ref(sdd_disjoin(x[1],x[2],manager),manager);
+  SddNode* g = sdd_ref(sdd_disjoin(x[2],x[3],manager),manager);
+  int maps[3][4] = {{0,1,0,0},{0,0,1,0},{0,0,0,1}};
+  for(int round=0; round<2; round++) {
+    //exists x1: x2 or x3, exists x2: true, exists x3: x1 or x2
+    CHECK(sdd_and_exists(f,g,maps[0],manager)==g);
+    CHECK(sdd_node_is_true(sdd_and_exists(f,g,maps[1],manager)));
+    CHECK(sdd_and_exists(f,g,maps[2],manager)==f);
+    SddNode* roots[2] = {f,g};
+    sdd_manager_compact(2,roots,manager);
+    f = roots[0];
+    g = roots[1];
+  }
+  sdd_manager_free(manager);
+}
+
+int main(void) {
+  check_cache_contexts();
+
+  for(int round=0; round<20; round++) {
+    TestCnf cnfs[2];
+    for(int i=0; i<2; i++) random_cnf(VAR_COUNT,VAR_COUNT,3,cnfs+i);
+
+    SddManager* manager = sdd_manager_create(VAR_COUNT,round%2); //auto mode in odd rounds
+    SddNode* f = compile_cnf(cnfs,manager);
+    SddNode* g = compile_cnf(cnfs+1,manager);
+
+    int exists_map[1+VAR_COUNT] = {0};
+    Assignment mask = 0;
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) {
+      exists_map[var] = test_random()%2;
+      if(exists_map[var]) mask |= 1UL << (var-1);
+    }
+    SddNode* node = sdd_ref(sdd_and_exists(f,g,exists_map,manager),manager);
+
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      if(a & mask) continue; //result does not depend on exists vars
+      int value = 0;
+      Assignment b = mask;
+      do { //subsets of mask
+        value = eval_cnf(cnfs,a|b) && eval_cnf(cnfs+1,a|b);
+        b = (b-1) & mask;
+      } while(!value && b!=mask);
+      CHECK(eval_sdd(node,a)==value);
+    }
+
+    sdd_deref(f,manager);
+    sdd_deref(g,manager);
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,71 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include <math.h>
+#include "test.h"
+
+/****************************************************************************************
+ * auto minimization under the fixed ('f') and adaptive ('g') search policies: searches
+ * triggered during compilation (focused on subtrees under 'g') preserve functions, with
+ * the default search function and with sifting
+ *
+ * searches that achieve no reduction raise the thresholds of 'g' (in terms of the growth
+ * they allow), while the thresholds of 'f' stay fixed
+ ****************************************************************************************/
+
+#define VAR_COUNT 16
+
+static Vtree* no_search(Vtree* vtree, SddManager* manager) {
+  (void)manager;
+  return vtree;
+}
+
+static void check_thresholds(TestCnf* cnf) {
+  const char thresholds[] = { 'g', 'l', 'a' };
+  float initial[3], adapted[3];
+  for(int policy=0; policy<2; policy++) {
+    SddManager* manager = sdd_manager_create(VAR_COUNT,1);
+    sdd_manager_set_auto_search_policy(policy? 'g': 'f',manager);
+    sdd_manager_set_minimize_function(no_search,manager);
+    for(int t=0; t<3; t++) initial[t] = sdd_manager_auto_search_growth(thresholds[t],manager);
+    SddNode* node = compile_cnf(cnf,manager);
+    for(int t=0; t<3; t++) adapted[t] = sdd_manager_auto_search_growth(thresholds[t],manager);
+    for(int t=0; t<3; t++) {
+      if(policy) CHECK(adapted[t]>initial[t]);
+      else CHECK(adapted[t]==initial[t]);
+    }
+    //all thresholds are scaled by the same factor
+    float scale = (adapted[0]-1)/(initial[0]-1);
+    for(int t=1; t<3; t++) CHECK(fabsf((adapted[t]-1)-scale*(initial[t]-1))<1e-4);
+    sdd_manager_set_auto_search_policy('g',manager); //resets the thresholds
+    for(int t=0; t<3; t++) CHECK(sdd_manager_auto_search_growth(thresholds[t],manager)==initial[t]);
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+}
+
+int main(void) {
+  for(int round=0; round<12; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,(SddSize)(3.5*VAR_COUNT),3,&cnf);
+
+    for(int policy=0; policy<2; policy++) {
+      SddManager* manager = sdd_manager_create(VAR_COUNT,1);
+      sdd_manager_set_auto_search_policy(policy? 'g': 'f',manager);
+      if(round%3==2) sdd_manager_set_minimize_function(sdd_vtree_minimize_sift_limited,manager);
+      SddNode* node = compile_cnf(&cnf,manager);
+      CHECK(same_as_cnf(node,&cnf));
+      sdd_deref(node,manager);
+      sdd_manager_free(manager);
+    }
+    if(round<4) check_thresholds(&cnf);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
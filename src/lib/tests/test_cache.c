@@ -0,0 +1,210 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include <dirent.h>
+#include <unistd.h>
+#include "test.h"
+
+/****************************************************************************************
+ * persistent vtree cache: a saved vtree is read back for the same cnf, the vtree of a
+ * similar cnf (with a variable added or removed) is adapted to its variables (pairing an
+ * added variable with a variable of its clause, dropping a removed one), and
+ * saving to a directory that cannot be written, or reading a corrupt entry, fails softly
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+static int same_vtree(Vtree* v1, Vtree* v2) {
+  if(sdd_vtree_is_leaf(v1) || sdd_vtree_is_leaf(v2)) {
+    return sdd_vtree_is_leaf(v1) && sdd_vtree_is_leaf(v2) && sdd_vtree_var(v1)==sdd_vtree_var(v2);
+  }
+  return same_vtree(sdd_vtree_left(v1),sdd_vtree_left(v2)) && same_vtree(sdd_vtree_right(v1),sdd_vtree_right(v2));
+}
+
+//cached is vtree with the leaf of var replaced by an internal node (var added)
+static int same_vtree_with_pair(Vtree* cached, Vtree* vtree, SddLiteral var, SddLiteral added) {
+  if(sdd_vtree_is_leaf(vtree) && sdd_vtree_var(vtree)==var) {
+    return !sdd_vtree_is_leaf(cached) &&
+           sdd_vtree_is_leaf(sdd_vtree_left(cached)) && sdd_vtree_var(sdd_vtree_left(cached))==var &&
+           sdd_vtree_is_leaf(sdd_vtree_right(cached)) && sdd_vtree_var(sdd_vtree_right(cached))==added;
+  }
+  if(sdd_vtree_is_leaf(vtree) || sdd_vtree_is_leaf(cached)) return same_vtree(cached,vtree);
+  return same_vtree_with_pair(sdd_vtree_left(cached),sdd_vtree_left(vtree),var,added) &&
+         same_vtree_with_pair(sdd_vtree_right(cached),sdd_vtree_right(vtree),var,added);
+}
+
+//cached is vtree without the leaf of var (its parent replaced by its sibling)
+static int same_vtree_without(Vtree* cached, Vtree* vtree, SddLiteral var) {
+  if(sdd_vtree_is_leaf(vtree)) return same_vtree(cached,vtree);
+  Vtree* left  = sdd_vtree_left(vtree);
+  Vtree* right = sdd_vtree_right(vtree);
+  if(sdd_vtree_is_leaf(left) && sdd_vtree_var(left)==var) return same_vtree(cached,right);
+  if(sdd_vtree_is_leaf(right) && sdd_vtree_var(right)==var) return same_vtree_without(cached,left,var);
+  if(sdd_vtree_is_leaf(cached)) return 0;
+  return same_vtree_without(sdd_vtree_left(cached),left,var) &&
+         same_vtree_without(sdd_vtree_right(cached),right,var);
+}
+
+//counts the leaves of each var of vtree in seen
+static void count_leaves(Vtree* vtree, SddLiteral var_count, int* seen) {
+  if(sdd_vtree_is_leaf(vtree)) {
+    SddLiteral var = sdd_vtree_var(vtree);
+    CHECK(var>=1 && var<=var_count);
+    seen[var]++;
+  }
+  else {
+    count_leaves(sdd_vtree_left(vtree),var_count,seen);
+    count_leaves(sdd_vtree_right(vtree),var_count,seen);
+  }
+}
+
+//vtree has one leaf for each var of cnf, and cnf compiles correctly under it (vtree is freed)
+static void check_vtree(Vtree* vtree, TestCnf* cnf) {
+  CHECK(vtree!=NULL);
+  int seen[2+VAR_COUNT] = {0};
+  count_leaves(vtree,cnf->var_count,seen);
+  for(SddLiteral var=1; var<=cnf->var_count; var++) CHECK(seen[var]==1);
+  SddManager* manager = sdd_manager_new(vtree);
+  sdd_vtree_free(vtree);
+  SddNode* node = compile_cnf(cnf,manager);
+  CHECK(same_as_cnf(node,cnf));
+  sdd_deref(node,manager);
+  sdd_manager_free(manager);
+}
+
+static void clauses_of(TestCnf* cnf, SddLiteral** clauses) {
+  for(SddSize i=0; i<cnf->clause_count; i++) clauses[i] = cnf->literals[i];
+}
+
+static void remove_directory(const char* directory) {
+  DIR* dir = opendir(directory);
+  CHECK(dir!=NULL);
+  char path[1024];
+  for(struct dirent* entry=readdir(dir); entry; entry=readdir(dir)) {
+    if(strcmp(entry->d_name,".")==0 || strcmp(entry->d_name,"..")==0) continue;
+    snprintf(path,sizeof(path),"%s/%s",directory,entry->d_name);
+    CHECK(unlink(path)==0);
+  }
+  closedir(dir);
+  CHECK(rmdir(directory)==0);
+}
+
+//truncates or corrupts the (only) entry file of directory, and returns the number of
+//files in directory (temporary files of saves must not be left behind)
+static int damage_entry(const char* directory, int truncate) {
+  DIR* dir = opendir(directory);
+  CHECK(dir!=NULL);
+  char path[1024];
+  int count = 0;
+  for(struct dirent* entry=readdir(dir); entry; entry=readdir(dir)) {
+    if(strcmp(entry->d_name,".")==0 || strcmp(entry->d_name,"..")==0) continue;
+    ++count;
+    size_t length = strlen(entry->d_name);
+    if(length<6 || strcmp(entry->d_name+length-6,".vtree")) continue;
+    snprintf(path,sizeof(path),"%s/%s",directory,entry->d_name);
+    FILE* file = fopen(path,"r+");
+    CHECK(file!=NULL);
+    CHECK(fseek(file,0,SEEK_END)==0);
+    long size = ftell(file);
+    if(truncate) CHECK(ftruncate(fileno(file),size/2)==0);
+    else { //the root gets node 0 (already a child) as right child
+      CHECK(fseek(file,size-4,SEEK_SET)==0);
+      CHECK(fprintf(file,"%2d\n",0)>0);
+    }
+    fclose(file);
+  }
+  closedir(dir);
+  return count;
+}
+
+//a corrupt entry of cnf is not read, and saving it again replaces it
+static void check_corrupt_entry(const char* directory, TestCnf* cnf) {
+  SddLiteral* clauses[TEST_MAX_CLAUSES];
+  clauses_of(cnf,clauses);
+  Vtree* vtree = sdd_vtree_new_from_cnf(cnf->var_count,cnf->clause_count,cnf->lengths,clauses,"min-fill");
+  for(int truncate=0; truncate<2; truncate++) {
+    CHECK(sdd_vtree_cache_save_cnf(directory,cnf->var_count,cnf->clause_count,cnf->lengths,clauses,vtree)==1);
+    CHECK(damage_entry(directory,truncate)==2); //entry and index
+    CHECK(sdd_vtree_cache_read_cnf(directory,cnf->var_count,cnf->clause_count,cnf->lengths,clauses)==NULL);
+  }
+  CHECK(sdd_vtree_cache_save_cnf(directory,cnf->var_count,cnf->clause_count,cnf->lengths,clauses,vtree)==1);
+  Vtree* cached = sdd_vtree_cache_read_cnf(directory,cnf->var_count,cnf->clause_count,cnf->lengths,clauses);
+  CHECK(cached!=NULL && same_vtree(cached,vtree));
+  sdd_vtree_free(cached);
+  sdd_vtree_free(vtree);
+}
+
+int main(void) {
+  char directory[] = "/tmp/sdd_cache_XXXXXX";
+  CHECK(mkdtemp(directory)!=NULL);
+  char missing[sizeof(directory)+8];
+  snprintf(missing,sizeof(missing),"%s/missing",directory);
+
+  char corrupt[] = "/tmp/sdd_cache_XXXXXX";
+  CHECK(mkdtemp(corrupt)!=NULL);
+  TestCnf first;
+  random_cnf(VAR_COUNT,2*VAR_COUNT,3,&first);
+  check_corrupt_entry(corrupt,&first);
+  remove_directory(corrupt);
+
+  for(int round=0; round<10; round++) {
+    TestCnf cnf;
+    SddLiteral* clauses[TEST_MAX_CLAUSES];
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+    clauses_of(&cnf,clauses);
+
+    if(round==0) CHECK(sdd_vtree_cache_read_cnf(directory,VAR_COUNT,cnf.clause_count,cnf.lengths,clauses)==NULL);
+
+    Vtree* vtree = sdd_vtree_new_from_cnf(VAR_COUNT,cnf.clause_count,cnf.lengths,clauses,"min-fill");
+    CHECK(sdd_vtree_cache_save_cnf(missing,VAR_COUNT,cnf.clause_count,cnf.lengths,clauses,vtree)==0);
+    CHECK(sdd_vtree_cache_save_cnf(directory,VAR_COUNT,cnf.clause_count,cnf.lengths,clauses,vtree)==1);
+    CHECK(sdd_vtree_cache_save_cnf(directory,VAR_COUNT,cnf.clause_count,cnf.lengths,clauses,vtree)==1); //already indexed
+
+    //same cnf: the saved vtree
+    Vtree* cached = sdd_vtree_cache_read_cnf(directory,VAR_COUNT,cnf.clause_count,cnf.lengths,clauses);
+    CHECK(cached!=NULL && same_vtree(cached,vtree));
+    sdd_vtree_free(cached);
+
+    //similar cnf with a new variable (in a new clause), paired with the other variable
+    //of the clause
+    TestCnf added = cnf;
+    added.var_count = VAR_COUNT+1;
+    added.lengths[added.clause_count]     = 2;
+    added.literals[added.clause_count][0] = VAR_COUNT+1;
+    added.literals[added.clause_count][1] = -(1+round%VAR_COUNT);
+    ++added.clause_count;
+    clauses_of(&added,clauses);
+    cached = sdd_vtree_cache_read_cnf(directory,added.var_count,added.clause_count,added.lengths,clauses);
+    CHECK(cached!=NULL && same_vtree_with_pair(cached,vtree,1+round%VAR_COUNT,VAR_COUNT+1));
+    check_vtree(cached,&added);
+
+    //similar cnf without the last variable (clauses mentioning it are dropped)
+    TestCnf removed = cnf;
+    removed.var_count    = VAR_COUNT-1;
+    removed.clause_count = 0;
+    for(SddSize i=0; i<cnf.clause_count; i++) {
+      int keep = 1;
+      for(SddLiteral j=0; j<cnf.lengths[i]; j++) keep &= labs(cnf.literals[i][j])!=VAR_COUNT;
+      if(keep) {
+        removed.lengths[removed.clause_count] = cnf.lengths[i];
+        memcpy(removed.literals[removed.clause_count],cnf.literals[i],sizeof(cnf.literals[i]));
+        ++removed.clause_count;
+      }
+    }
+    clauses_of(&removed,clauses);
+    cached = sdd_vtree_cache_read_cnf(directory,removed.var_count,removed.clause_count,removed.lengths,clauses);
+    CHECK(cached!=NULL && same_vtree_without(cached,vtree,VAR_COUNT));
+    check_vtree(cached,&removed);
+    sdd_vtree_free(vtree);
+  }
+
+  remove_directory(directory);
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
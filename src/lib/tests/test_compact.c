@@ -0,0 +1,164 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * compaction: relocated roots keep their functions, and the manager remains usable;
+ * nodes held by a reach manager are relocated too
+ *
+ * relocated nodes keep their ids, are laid out after their primes and subs, and keep
+ * their computed results: repeating an apply finds the relocated result
+ *
+ * element arrays freed from the compaction array are handed out again
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+#define ROOT_COUNT 3
+
+//the decision primes and subs of node are placed before it
+static void check_layout(SddNode* node) {
+  if(!sdd_node_is_decision(node)) return;
+  SddNode** elements = sdd_node_elements(node);
+  for(SddNodeSize i=0; i<2*sdd_node_size(node); i++) {
+    if(sdd_node_is_decision(elements[i])) CHECK(elements[i]<node);
+    check_layout(elements[i]);
+  }
+}
+
+//pairs (1,2) and (3,4): next bit 1 copies current bit 1, next bit 2 negates current bit 2
+static void check_reach_manager(void) {
+  SddManager* manager = sdd_manager_create(4,0);
+  SddLiteral current[2] = {1,3}, next[2] = {2,4};
+  SddNode* partitions[2];
+  partitions[0] = sdd_equiv(sdd_manager_literal(1,manager),sdd_manager_literal(2,manager),manager);
+  partitions[1] = sdd_xor(sdd_manager_literal(3,manager),sdd_manager_literal(4,manager),manager);
+  ReachManager* reach_manager = reach_manager_new(2,current,next,2,partitions,manager);
+
+  sdd_manager_compact(0,NULL,manager); //only the partitions are live
+  CHECK(sdd_manager_live_count(manager)==2);
+
+  SddNode* states = sdd_conjoin(sdd_manager_literal(1,manager),sdd_manager_literal(3,manager),manager);
+  SddNode* image  = reach_image(states,reach_manager); //x1 and ~x3
+  for(Assignment a=0; a<16; a++) {
+    CHECK(eval_sdd(image,a)==(value_of(1,a) && !value_of(3,a)));
+  }
+  reach_manager_free(reach_manager);
+  sdd_manager_free(manager);
+}
+
+//range [*first,*last) of the element arrays of the decision nodes of node
+static void element_range(SddNode* node, SddNode*** first, SddNode*** last) {
+  if(!sdd_node_is_decision(node)) return;
+  SddNode** elements = sdd_node_elements(node);
+  SddNode** end      = elements+2*sdd_node_size(node);
+  if(*first==NULL || elements<*first) *first = elements;
+  if(*last==NULL  || end>*last) *last = end;
+  for(SddNodeSize i=0; i<2*sdd_node_size(node); i++) element_range(elements[i],first,last);
+}
+
+//number of decision nodes of node whose size is at least 4 (such nodes do not keep their
+//element arrays when gc'd) and whose element array lies in [first,last) (if first is
+//not NULL)
+static SddSize count_in_range(SddNode* node, SddNode** first, SddNode** last, int* visited) {
+  if(!sdd_node_is_decision(node) || visited[sdd_id(node)]) return 0;
+  visited[sdd_id(node)] = 1;
+  SddNode** elements = sdd_node_elements(node);
+  SddSize count = sdd_node_size(node)>=4 && (first==NULL || (elements>=first && elements<last));
+  for(SddNodeSize i=0; i<2*sdd_node_size(node); i++) count += count_in_range(elements[i],first,last,visited);
+  return count;
+}
+
+//the nodes of an exactly-k constraint on a balanced vtree have up to 1+VAR_COUNT/2 elements
+static void check_element_reuse(int k) {
+  SddLiteral vars[VAR_COUNT];
+  for(int i=0; i<VAR_COUNT; i++) vars[i] = i+1;
+  Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+  SddManager* manager = sdd_manager_new(vtree);
+  sdd_vtree_free(vtree);
+
+  SddNode* node = sdd_ref(sdd_exactly_k(k,VAR_COUNT,vars,manager),manager);
+  int* visited = calloc(sdd_id(node)+1,sizeof(int));
+  CHECK(count_in_range(node,NULL,NULL,visited) > 0);
+  free(visited);
+  sdd_manager_compact(1,&node,manager);
+  SddNode** first = NULL;
+  SddNode** last  = NULL;
+  element_range(node,&first,&last);
+  sdd_deref(node,manager);
+  sdd_manager_garbage_collect(manager); //element arrays of large nodes are freed
+
+  node = sdd_ref(sdd_exactly_k(k,VAR_COUNT,vars,manager),manager);
+  for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+    int ones = 0;
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) ones += value_of(var,a);
+    CHECK(eval_sdd(node,a)==(ones==k));
+  }
+  visited = calloc(sdd_id(node)+1,sizeof(int));
+  CHECK(count_in_range(node,first,last,visited) > 0);
+  free(visited);
+  sdd_deref(node,manager);
+  sdd_manager_free(manager);
+}
+
+int main(void) {
+  check_reach_manager();
+  for(int k=3; k<=VAR_COUNT/2; k++) check_element_reuse(k);
+
+  for(int round=0; round<10; round++) {
+    TestCnf cnfs[ROOT_COUNT];
+    for(int i=0; i<ROOT_COUNT; i++) random_cnf(VAR_COUNT,2*VAR_COUNT,3,cnfs+i);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+
+    SddNode* roots[ROOT_COUNT];
+    for(int i=0; i<ROOT_COUNT; i++) roots[i] = compile_cnf(cnfs+i,manager);
+    SddNode* dropped = compile_cnf(cnfs,manager); //dead after deref: gc'd by compaction
+    sdd_deref(dropped,manager);
+    //the conjunction of two roots is kept as a root, so its computation survives
+    SddNode* conjunction = sdd_ref(sdd_conjoin(roots[1],roots[2],manager),manager);
+    SddSize live = sdd_manager_live_count(manager);
+    SddSize ids[ROOT_COUNT];
+    for(int i=0; i<ROOT_COUNT; i++) ids[i] = sdd_id(roots[i]);
+
+    SddNode* kept[ROOT_COUNT+1];
+    for(int i=0; i<ROOT_COUNT; i++) kept[i] = roots[i];
+    kept[ROOT_COUNT] = conjunction;
+    sdd_manager_compact(ROOT_COUNT+1,kept,manager);
+    for(int i=0; i<ROOT_COUNT; i++) roots[i] = kept[i];
+    conjunction = kept[ROOT_COUNT];
+    CHECK(sdd_manager_dead_count(manager)==0);
+    CHECK(sdd_manager_live_count(manager)==live);
+    for(int i=0; i<ROOT_COUNT; i++) {
+      CHECK(sdd_id(roots[i])==ids[i]);
+      check_layout(roots[i]);
+      CHECK(same_as_cnf(roots[i],cnfs+i));
+    }
+
+    //repeating the conjunction finds the relocated result without creating nodes
+    SddSize count = sdd_manager_count(manager);
+    CHECK(sdd_conjoin(roots[1],roots[2],manager)==conjunction);
+    CHECK(sdd_manager_count(manager)==count);
+    sdd_deref(conjunction,manager);
+
+    //compact again after new nodes were created past the compaction arrays
+    SddNode* node = sdd_ref(sdd_conjoin(roots[0],roots[1],manager),manager);
+    sdd_manager_minimize(manager);
+    sdd_deref(node,manager);
+    sdd_manager_compact(ROOT_COUNT,roots,manager);
+    for(int i=0; i<ROOT_COUNT; i++) CHECK(same_as_cnf(roots[i],cnfs+i));
+
+    for(int i=0; i<ROOT_COUNT; i++) sdd_deref(roots[i],manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,60 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * functional composition: substituting sdds for variables (one, or several at once)
+ ****************************************************************************************/
+
+#define VAR_COUNT 8
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    TestCnf cnfs[1+VAR_COUNT];
+    for(int i=0; i<=VAR_COUNT; i++) random_cnf(VAR_COUNT,i? 2: VAR_COUNT,3,cnfs+i);
+
+    SddManager* manager = sdd_manager_create(VAR_COUNT,round%2); //auto mode in odd rounds
+    SddNode* node = compile_cnf(cnfs,manager);
+    SddNode* compose_map[1+VAR_COUNT] = {NULL};
+    SddNode* gs[1+VAR_COUNT];
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) {
+      gs[var] = compile_cnf(cnfs+var,manager); //sdd for var
+      if(test_random()%2) compose_map[var] = gs[var];
+    }
+
+    //single variable
+    SddLiteral var = 1+test_random()%VAR_COUNT;
+    SddNode* single = sdd_ref(sdd_compose(node,var,gs[var],manager),manager);
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      Assignment b = eval_cnf(cnfs+var,a)? a | (1UL << (var-1)): a & ~(1UL << (var-1));
+      CHECK(eval_sdd(single,a)==eval_cnf(cnfs,b));
+    }
+
+    //simultaneous substitution
+    SddNode* vector = sdd_ref(sdd_vector_compose(node,compose_map,manager),manager);
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      Assignment b = a;
+      for(SddLiteral v=1; v<=VAR_COUNT; v++) {
+        if(compose_map[v]==NULL) continue;
+        if(eval_cnf(cnfs+v,a)) b |= 1UL << (v-1);
+        else b &= ~(1UL << (v-1));
+      }
+      CHECK(eval_sdd(vector,a)==eval_cnf(cnfs,b));
+    }
+
+    sdd_deref(single,manager);
+    sdd_deref(vector,manager);
+    sdd_deref(node,manager);
+    for(SddLiteral v=1; v<=VAR_COUNT; v++) sdd_deref(gs[v],manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,71 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * cardinality, parity and pseudo-boolean constraints
+ *
+ * pseudo-boolean weights with a common factor give the same sdd as the reduced weights
+ ****************************************************************************************/
+
+#define VAR_COUNT 10
+
+int main(void) {
+  const char* types[] = { "balanced", "right", "left", "random" };
+  for(int round=0; round<20; round++) {
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,types[round%4]);
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+
+    SddLiteral vars[VAR_COUNT];
+    SddLiteral count = 0;
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) if(test_random()%3) vars[count++] = var;
+    SddLiteral k = test_random()%(count+2); //may exceed count
+    SddLiteral weights[1+VAR_COUNT] = {0};
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) weights[var] = (SddLiteral) (test_random()%11)-5;
+    SddLiteral bound = (SddLiteral) (test_random()%13)-6;
+
+    SddNode* at_most  = sdd_ref(sdd_at_most_k(k,count,vars,manager),manager);
+    SddNode* at_least = sdd_ref(sdd_at_least_k(k,count,vars,manager),manager);
+    SddNode* exactly  = sdd_ref(sdd_exactly_k(k,count,vars,manager),manager);
+    SddNode* parity   = sdd_ref(sdd_parity(count,vars,manager),manager);
+    SddNode* linear   = sdd_ref(sdd_linear_leq(weights,bound,manager),manager);
+    //scaled by a factor, with the bound anywhere below the next multiple
+    SddLiteral factors[] = { 3, 1000, 1L<<20 };
+    SddLiteral factor = factors[round%3];
+    SddLiteral scaled_weights[1+VAR_COUNT] = {0};
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) scaled_weights[var] = factor*weights[var];
+    SddLiteral scaled_bound = factor*bound+(SddLiteral) (test_random()%factor);
+    SddNode* scaled = sdd_linear_leq(scaled_weights,scaled_bound,manager);
+    CHECK(scaled==linear);
+
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      SddLiteral ones = 0;
+      for(SddLiteral i=0; i<count; i++) ones += value_of(vars[i],a);
+      SddLiteral sum = 0;
+      for(SddLiteral var=1; var<=VAR_COUNT; var++) sum += weights[var]*value_of(var,a);
+      CHECK(eval_sdd(at_most,a)==(ones <= k));
+      CHECK(eval_sdd(at_least,a)==(ones >= k));
+      CHECK(eval_sdd(exactly,a)==(ones == k));
+      CHECK(eval_sdd(parity,a)==(ones%2));
+      CHECK(eval_sdd(linear,a)==(sum <= bound));
+      CHECK(eval_sdd(scaled,a)==(factor*sum <= scaled_bound));
+    }
+
+    sdd_deref(at_most,manager);
+    sdd_deref(at_least,manager);
+    sdd_deref(exactly,manager);
+    sdd_deref(parity,manager);
+    sdd_deref(linear,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
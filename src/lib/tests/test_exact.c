@@ -0,0 +1,130 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include <unistd.h>
+#include "test.h"
+
+/****************************************************************************************
+ * exact window search: minimization with an exact window preserves functions, and
+ * finds sizes no larger than local search alone (the exact pass follows local search,
+ * which is deterministic when unlimited)
+ *
+ * a window covering a small vtree reaches the smallest size over all vtrees, found by
+ * compiling under every vtree (every var order and shape)
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+#define SMALL_VAR_COUNT 5
+
+//number of vtree shapes with n leaves
+static SddSize shape_count(SddLiteral n) {
+  if(n==1) return 1;
+  SddSize count = 0;
+  for(SddLiteral k=1; k<n; k++) count += shape_count(k)*shape_count(n-k);
+  return count;
+}
+
+//writes the vtree with shape s over vars[offset..offset+n-1] (in this order) to file,
+//using in-order positions as ids; returns the id of its root
+static SddLiteral write_shape(FILE* file, SddLiteral* vars, SddLiteral offset, SddLiteral n, SddSize s) {
+  if(n==1) {
+    fprintf(file,"L %ld %ld\n",2*offset,vars[offset]);
+    return 2*offset;
+  }
+  SddLiteral k = 1;
+  while(s >= shape_count(k)*shape_count(n-k)) s -= shape_count(k)*shape_count(n-k), ++k;
+  SddLiteral left  = write_shape(file,vars,offset,k,s%shape_count(k));
+  SddLiteral right = write_shape(file,vars,offset+k,n-k,s/shape_count(k));
+  SddLiteral id    = 2*(offset+k-1)+1;
+  fprintf(file,"I %ld %ld %ld\n",id,left,right);
+  return id;
+}
+
+//smallest size of cnf under vtrees whose var order is a permutation of vars[i..n-1]
+static SddSize smallest_size(TestCnf* cnf, SddLiteral* vars, SddLiteral i, const char* path) {
+  SddLiteral n = cnf->var_count;
+  SddSize best = (SddSize)-1;
+  if(i==n) {
+    for(SddSize s=0; s<shape_count(n); s++) {
+      FILE* file = fopen(path,"w");
+      CHECK(file!=NULL);
+      fprintf(file,"vtree %ld\n",2*n-1);
+      write_shape(file,vars,0,n,s);
+      fclose(file);
+      Vtree* vtree = sdd_vtree_read(path);
+      SddManager* manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+      compile_cnf(cnf,manager);
+      SddSize size = sdd_manager_live_size(manager);
+      if(size < best) best = size;
+      sdd_manager_free(manager);
+    }
+    return best;
+  }
+  for(SddLiteral j=i; j<n; j++) {
+    SddLiteral v = vars[i]; vars[i] = vars[j]; vars[j] = v;
+    SddSize size = smallest_size(cnf,vars,i+1,path);
+    if(size < best) best = size;
+    v = vars[i]; vars[i] = vars[j]; vars[j] = v;
+  }
+  return best;
+}
+
+static void check_optimum(TestCnf* cnf, const char* path) {
+  SddLiteral vars[SMALL_VAR_COUNT];
+  for(SddLiteral i=0; i<SMALL_VAR_COUNT; i++) vars[i] = i+1;
+  SddSize best = smallest_size(cnf,vars,0,path);
+
+  SddManager* manager = sdd_manager_create(SMALL_VAR_COUNT,0);
+  sdd_manager_set_vtree_search_exact_window(SMALL_VAR_COUNT,manager);
+  SddNode* node = compile_cnf(cnf,manager);
+  sdd_manager_minimize(manager);
+  CHECK(sdd_manager_live_size(manager)==best);
+  CHECK(same_as_cnf(node,cnf));
+  sdd_deref(node,manager);
+  sdd_manager_free(manager);
+}
+
+int main(void) {
+  char path[] = "/tmp/sdd_exact_XXXXXX";
+  int fd = mkstemp(path);
+  CHECK(fd>=0);
+  close(fd);
+  for(int round=0; round<10; round++) {
+    TestCnf cnf;
+    random_cnf(SMALL_VAR_COUNT,SMALL_VAR_COUNT+round%3,3,&cnf);
+    check_optimum(&cnf,path);
+  }
+  CHECK(unlink(path)==0);
+
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+    SddLiteral window = 3+round%6; //3..8
+
+    SddSize sizes[2];
+    for(int exact=0; exact<2; exact++) {
+      Vtree* vtree = sdd_vtree_new(VAR_COUNT,round%2? "right": "balanced");
+      SddManager* manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+      sdd_manager_set_vtree_search_exact_window(exact? window: 0,manager);
+
+      SddNode* node = compile_cnf(&cnf,manager);
+      sdd_manager_minimize(manager);
+      CHECK(same_as_cnf(node,&cnf));
+      sizes[exact] = sdd_manager_live_size(manager);
+
+      sdd_deref(node,manager);
+      sdd_manager_free(manager);
+    }
+    CHECK(sizes[1]<=sizes[0]);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,60 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * incremental garbage collection: steps interleaved with applies keep referenced nodes
+ * intact and gc at most budget nodes each, and a completed sweep leaves no dead node
+ * without parents
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,"right");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+
+    //compile cnf, one gc step after each clause
+    SddNode* node = sdd_ref(sdd_manager_true(manager),manager);
+    for(SddSize i=0; i<cnf.clause_count; i++) {
+      SddNode* clause = sdd_manager_false(manager);
+      for(SddLiteral j=0; j<cnf.lengths[i]; j++) {
+        clause = sdd_disjoin(clause,sdd_manager_literal(cnf.literals[i][j],manager),manager);
+      }
+      SddNode* next = sdd_ref(sdd_conjoin(node,clause,manager),manager);
+      sdd_deref(node,manager);
+      node = next;
+      SddSize budget = 1+test_random()%64;
+      SddSize count  = sdd_manager_count(manager);
+      sdd_manager_gc_step(budget,manager);
+      CHECK(sdd_manager_count(manager)+budget>=count); //bounded pause
+    }
+    CHECK(same_as_cnf(node,&cnf));
+
+    //finish the sweep
+    while(!sdd_manager_gc_step(64,manager));
+    CHECK(same_as_cnf(node,&cnf));
+
+    //a full sweep after dereferencing everything gc's all nodes (parents before children)
+    sdd_deref(node,manager);
+    while(!sdd_manager_gc_step(64,manager)); //current sweep
+    while(!sdd_manager_gc_step(64,manager)); //full sweep
+    CHECK(sdd_manager_count(manager)==0);
+
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
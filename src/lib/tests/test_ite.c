@@ -0,0 +1,91 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * if-then-else, xor and equiv, with and without auto gc/minimize
+ ****************************************************************************************/
+
+#define VAR_COUNT 10
+
+static int search_count = 0;
+
+static Vtree* count_search(Vtree* vtree, SddManager* manager) {
+  (void) manager;
+  ++search_count;
+  return vtree;
+}
+
+//xor, equiv and ite are top-level applies: the first one invokes vtree search
+static void check_auto_search(SddNode* fn(SddManager* manager)) {
+  SddManager* manager = sdd_manager_create(2,1);
+  sdd_manager_set_minimize_function(count_search,manager);
+  search_count = 0;
+  SddNode* node = fn(manager);
+  CHECK(search_count==1);
+  CHECK(sdd_node_is_decision(node));
+  sdd_manager_free(manager);
+}
+
+static SddNode* xor_of_literals(SddManager* manager) {
+  return sdd_xor(sdd_manager_literal(1,manager),sdd_manager_literal(2,manager),manager);
+}
+
+static SddNode* equiv_of_literals(SddManager* manager) {
+  return sdd_equiv(sdd_manager_literal(1,manager),sdd_manager_literal(-2,manager),manager);
+}
+
+static SddNode* ite_of_literals(SddManager* manager) {
+  return sdd_ite(sdd_manager_literal(1,manager),sdd_manager_literal(2,manager),sdd_manager_literal(-2,manager),manager);
+}
+
+int main(void) {
+  check_auto_search(xor_of_literals);
+  check_auto_search(equiv_of_literals);
+  check_auto_search(ite_of_literals);
+
+  for(int round=0; round<20; round++) {
+    TestCnf cnfs[3];
+    for(int i=0; i<3; i++) random_cnf(VAR_COUNT,VAR_COUNT,3,cnfs+i);
+
+    SddManager* manager = sdd_manager_create(VAR_COUNT,round%2); //auto mode in odd rounds
+    SddNode* f = compile_cnf(cnfs,manager);
+    SddNode* g = compile_cnf(cnfs+1,manager);
+    SddNode* h = compile_cnf(cnfs+2,manager);
+
+    SddNode* ite   = sdd_ref(sdd_ite(f,g,h,manager),manager);
+    SddNode* xor   = sdd_ref(sdd_xor(f,g,manager),manager);
+    SddNode* equiv = sdd_ref(sdd_equiv(f,h,manager),manager);
+    SddNode* trivial[3]; //one apply or none
+    trivial[0] = sdd_ref(sdd_ite(f,g,g,manager),manager);
+    trivial[1] = sdd_ref(sdd_ite(f,sdd_manager_true(manager),h,manager),manager);
+    trivial[2] = sdd_ref(sdd_ite(f,g,sdd_manager_false(manager),manager),manager);
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      int fa = eval_cnf(cnfs,a), ga = eval_cnf(cnfs+1,a), ha = eval_cnf(cnfs+2,a);
+      CHECK(eval_sdd(ite,a)==(fa? ga: ha));
+      CHECK(eval_sdd(xor,a)==(fa!=ga));
+      CHECK(eval_sdd(equiv,a)==(fa==ha));
+      CHECK(eval_sdd(trivial[0],a)==ga);
+      CHECK(eval_sdd(trivial[1],a)==(fa || ha));
+      CHECK(eval_sdd(trivial[2],a)==(fa && ga));
+    }
+
+    sdd_deref(f,manager);
+    sdd_deref(g,manager);
+    sdd_deref(h,manager);
+    sdd_deref(ite,manager);
+    sdd_deref(xor,manager);
+    sdd_deref(equiv,manager);
+    for(int i=0; i<3; i++) sdd_deref(trivial[i],manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
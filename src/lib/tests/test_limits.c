@@ -0,0 +1,70 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * limited vtree operations: an operation that exceeds its limits is rolled back, leaving
+ * the vtree, the size and the functions as they were
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+//random internal vtree node, NULL if none is found
+static Vtree* random_internal_node(Vtree* vtree) {
+  while(!sdd_vtree_is_leaf(vtree)) {
+    Vtree* child = test_random()%2? sdd_vtree_left(vtree): sdd_vtree_right(vtree);
+    if(sdd_vtree_is_leaf(child) || test_random()%3==0) return vtree;
+    vtree = child;
+  }
+  return NULL;
+}
+
+int main(void) {
+  SddSize rolled_back = 0;
+  for(int round=0; round<10; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    sdd_manager_set_vtree_operation_size_limit(1.05,manager); //tight: many rollbacks
+
+    SddNode* node = compile_cnf(&cnf,manager);
+    for(int i=0; i<30; i++) {
+      Vtree* v = random_internal_node(sdd_manager_vtree(manager));
+      if(v==NULL) continue;
+      Vtree* left  = sdd_vtree_left(v);
+      Vtree* right = sdd_vtree_right(v);
+      sdd_manager_garbage_collect(manager); //operations expect no dead nodes
+      SddSize size = sdd_manager_size(manager);
+      sdd_manager_init_vtree_size_limit(sdd_manager_vtree(manager),manager);
+      int done;
+      switch(test_random()%3) {
+        case 0:  done = sdd_vtree_swap(v,manager,1); break;
+        case 1:  if(sdd_vtree_is_leaf(left)) continue; //(w=(a b) c) ===> (a x=(b c))
+                 done = sdd_vtree_rotate_right(v,manager,1); break;
+        default: if(sdd_vtree_is_leaf(right)) continue; //(a x=(b c)) ===> (x=(a b) c)
+                 done = sdd_vtree_rotate_left(right,manager,1); break;
+      }
+      if(!done) {
+        ++rolled_back;
+        CHECK(sdd_manager_size(manager)==size);
+      }
+      CHECK(same_as_cnf(node,&cnf));
+    }
+
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+  CHECK(rolled_back > 0);
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
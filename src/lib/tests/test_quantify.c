@@ -0,0 +1,70 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * universal quantification over many variables and mixed quantifier prefixes
+ ****************************************************************************************/
+
+#define VAR_COUNT 10
+#define BLOCK_COUNT 3
+
+static TestCnf cnf;
+static SddSize var_blocks[1+VAR_COUNT];
+static char quantifiers[BLOCK_COUNT];
+
+//value of Q_block X_block ... Q_n X_n: cnf under a (vars of blocks < block are set in a)
+static int eval_prefix(SddSize block, Assignment a) {
+  if(block > BLOCK_COUNT) return eval_cnf(&cnf,a);
+  Assignment mask = 0;
+  for(SddLiteral var=1; var<=VAR_COUNT; var++) {
+    if(var_blocks[var]==block) mask |= 1UL << (var-1);
+  }
+  int exists = quantifiers[block-1]=='e';
+  Assignment b = mask;
+  do { //subsets of mask
+    int value = eval_prefix(block+1,(a & ~mask) | b);
+    if(value==exists) return value;
+    b = (b-1) & mask;
+  } while(b!=mask);
+  return !exists;
+}
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    random_cnf(VAR_COUNT,VAR_COUNT,3,&cnf);
+    SddManager* manager = sdd_manager_create(VAR_COUNT,round%2); //auto mode in odd rounds
+    SddNode* node = compile_cnf(&cnf,manager);
+
+    //forall over a random set of vars (one block)
+    int forall_map[1+VAR_COUNT] = {0};
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) {
+      forall_map[var] = test_random()%3==0;
+      var_blocks[var] = forall_map[var];
+    }
+    quantifiers[0] = 'a';
+    quantifiers[1] = quantifiers[2] = 'e'; //blocks 2 and 3 are empty
+    SddNode* forall = sdd_ref(sdd_forall_multiple(forall_map,node,manager),manager);
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) CHECK(eval_sdd(forall,a)==eval_prefix(1,a));
+
+    //random prefix
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) var_blocks[var] = test_random()%(1+BLOCK_COUNT);
+    for(int i=0; i<BLOCK_COUNT; i++) quantifiers[i] = test_random()%2? 'e': 'a';
+    SddNode* prefix = sdd_ref(sdd_quantify_prefix(BLOCK_COUNT,quantifiers,var_blocks,node,manager),manager);
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) CHECK(eval_sdd(prefix,a)==eval_prefix(1,a));
+
+    sdd_deref(forall,manager);
+    sdd_deref(prefix,manager);
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,148 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * reachability over a random transition relation on BITS state bits
+ *
+ * state bit i is current var 2i+1 and next var 2i+2 (interleaved); the relation is given
+ * by one partition per next bit: next bit i is a random function of the current state,
+ * or is free (any value) for some states, so states may have several successors
+ ****************************************************************************************/
+
+#define BITS 4
+#define STATES (1u << BITS)
+
+static int relation[STATES][STATES]; //relation[s][t]: t is a successor of s
+
+//sdd of a set of states over current vars
+static SddNode* states_sdd(int* set, SddManager* manager) {
+  SddNode* node = sdd_ref(sdd_manager_false(manager),manager);
+  for(unsigned s=0; s<STATES; s++) {
+    if(!set[s]) continue;
+    SddNode* term = sdd_ref(sdd_manager_true(manager),manager);
+    for(int i=0; i<BITS; i++) {
+      SddLiteral var = 2*i+1;
+      SddNode* next = sdd_ref(sdd_conjoin(term,sdd_manager_literal((s>>i)&1? var: -var,manager),manager),manager);
+      sdd_deref(term,manager);
+      term = next;
+    }
+    SddNode* next = sdd_ref(sdd_disjoin(node,term,manager),manager);
+    sdd_deref(node,manager);
+    sdd_deref(term,manager);
+    node = next;
+  }
+  return node;
+}
+
+//node over current vars equals set
+static int same_states(SddNode* node, int* set) {
+  for(unsigned s=0; s<STATES; s++) {
+    Assignment a = 0;
+    for(int i=0; i<BITS; i++) if((s>>i)&1) a |= 1UL << (2*i);
+    if(eval_sdd(node,a)!=set[s]) return 0;
+  }
+  return 1;
+}
+
+//partition i: next bit i is out[s][i] for state s, or free if free[s][i]
+static SddNode* partition(int i, int out[STATES][BITS], int free_bit[STATES][BITS], SddManager* manager) {
+  int set[STATES];
+  for(unsigned s=0; s<STATES; s++) set[s] = !free_bit[s][i] && out[s][i];
+  SddNode* one = states_sdd(set,manager); //next bit must be 1
+  for(unsigned s=0; s<STATES; s++) set[s] = !free_bit[s][i] && !out[s][i];
+  SddNode* zero = states_sdd(set,manager); //next bit must be 0
+  SddNode* y = sdd_manager_literal(2*i+2,manager);
+  //(one => y) and (zero => ~y)
+  SddNode* c1 = sdd_ref(sdd_disjoin(sdd_negate(one,manager),y,manager),manager);
+  SddNode* c2 = sdd_ref(sdd_disjoin(sdd_negate(zero,manager),sdd_negate(y,manager),manager),manager);
+  SddNode* node = sdd_ref(sdd_conjoin(c1,c2,manager),manager);
+  sdd_deref(one,manager);
+  sdd_deref(zero,manager);
+  sdd_deref(c1,manager);
+  sdd_deref(c2,manager);
+  return node;
+}
+
+static void image(int* set, int* result, int backward) {
+  for(unsigned t=0; t<STATES; t++) result[t] = 0;
+  for(unsigned s=0; s<STATES; s++) {
+    for(unsigned t=0; t<STATES; t++) {
+      if(backward? set[t] && relation[s][t]: set[s] && relation[s][t]) result[backward? s: t] = 1;
+    }
+  }
+}
+
+static void fixpoint(int* set, int* result, int backward) {
+  int next[STATES];
+  for(unsigned s=0; s<STATES; s++) result[s] = set[s];
+  for(int changed=1; changed; ) {
+    changed = 0;
+    image(result,next,backward);
+    for(unsigned s=0; s<STATES; s++) if(next[s] && !result[s]) result[s] = changed = 1;
+  }
+}
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    int out[STATES][BITS], free_bit[STATES][BITS];
+    for(unsigned s=0; s<STATES; s++) {
+      for(int i=0; i<BITS; i++) {
+        out[s][i]      = test_random()%2;
+        free_bit[s][i] = test_random()%8==0;
+      }
+    }
+    for(unsigned s=0; s<STATES; s++) {
+      for(unsigned t=0; t<STATES; t++) {
+        relation[s][t] = 1;
+        for(int i=0; i<BITS; i++) {
+          if(!free_bit[s][i] && ((t>>i)&1)!=(unsigned)out[s][i]) relation[s][t] = 0;
+        }
+      }
+    }
+
+    SddManager* manager = sdd_manager_create(2*BITS,round%2); //auto mode in odd rounds
+    SddLiteral current_vars[BITS], next_vars[BITS];
+    SddNode* partitions[BITS];
+    for(int i=0; i<BITS; i++) {
+      current_vars[i] = 2*i+1;
+      next_vars[i]    = 2*i+2;
+      partitions[i]   = partition(i,out,free_bit,manager);
+    }
+    ReachManager* reach_manager = reach_manager_new(BITS,current_vars,next_vars,BITS,partitions,manager);
+    for(int i=0; i<BITS; i++) sdd_deref(partitions[i],manager);
+
+    if(round%4==2) sdd_manager_add_var_after_last(manager); //maps are rebuilt
+
+    int set[STATES], expected[STATES];
+    for(unsigned s=0; s<STATES; s++) set[s] = test_random()%5==0;
+    SddNode* states = states_sdd(set,manager);
+
+    for(int backward=0; backward<=1; backward++) {
+      image(set,expected,backward);
+      SddNode* node = sdd_ref(backward? reach_preimage(states,reach_manager): reach_image(states,reach_manager),manager);
+      CHECK(same_states(node,expected));
+      sdd_deref(node,manager);
+
+      fixpoint(set,expected,backward);
+      node = sdd_ref(backward? reach_backward(states,reach_manager): reach_forward(states,reach_manager),manager);
+      CHECK(same_states(node,expected));
+      CHECK(reach_iteration_count(reach_manager)>=1);
+      CHECK(reach_stats(reach_manager)[0].live_count > 0); //reached states are live
+      sdd_deref(node,manager);
+    }
+
+    sdd_deref(states,manager);
+    reach_manager_free(reach_manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
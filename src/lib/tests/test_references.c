@@ -0,0 +1,52 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * deferred reference counting: counts and sizes agree with immediate mode once flushed
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+    SddManager* immediate = sdd_manager_new(vtree);
+    SddManager* deferred  = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    sdd_manager_deferred_refs_on(deferred);
+    CHECK(sdd_manager_is_deferred_refs_on(deferred));
+
+    SddNode* i_node = compile_cnf(&cnf,immediate);
+    SddNode* d_node = compile_cnf(&cnf,deferred);
+    sdd_manager_flush_deferred_refs(deferred);
+    CHECK(same_as_cnf(d_node,&cnf));
+    CHECK(sdd_manager_live_count(deferred)==sdd_manager_live_count(immediate));
+    CHECK(sdd_manager_dead_count(deferred)==sdd_manager_dead_count(immediate));
+    CHECK(sdd_manager_live_size(deferred)==sdd_manager_live_size(immediate));
+
+    //dereferencing in deferred mode, then leaving it (which flushes)
+    sdd_deref(d_node,deferred);
+    sdd_manager_deferred_refs_off(deferred);
+    CHECK(!sdd_manager_is_deferred_refs_on(deferred));
+    CHECK(sdd_manager_live_count(deferred)==0);
+    sdd_manager_garbage_collect(deferred);
+    CHECK(sdd_manager_count(deferred)==0);
+
+    sdd_deref(i_node,immediate);
+    sdd_manager_free(immediate);
+    sdd_manager_free(deferred);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
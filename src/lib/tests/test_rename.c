@@ -0,0 +1,70 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * renaming variables: structure-preserving renamings (swapping interleaved pairs) and
+ * arbitrary permutations
+ ****************************************************************************************/
+
+#define PAIRS 5
+#define VAR_COUNT (2*PAIRS)
+
+//assignment b with b[map[var]] = a[var]
+static Assignment rename_assignment(Assignment a, SddLiteral* map) {
+  Assignment b = 0;
+  for(SddLiteral var=1; var<=VAR_COUNT; var++) {
+    if(value_of(var,a)) b |= 1UL << (map[var]-1);
+  }
+  return b;
+}
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(PAIRS,PAIRS,3,&cnf);
+    for(SddSize i=0; i<cnf.clause_count; i++) { //cnf over odd (current) vars
+      for(SddLiteral j=0; j<cnf.lengths[i]; j++) {
+        SddLiteral l = cnf.literals[i][j];
+        cnf.literals[i][j] = l > 0? 2*l-1: -(2*(-l)-1);
+      }
+    }
+    cnf.var_count = VAR_COUNT;
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,round%2? "right": "balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    SddNode* node = compile_cnf(&cnf,manager);
+
+    SddLiteral swap[1+VAR_COUNT]; //current <-> next
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) swap[var] = var%2? var+1: var-1;
+    SddLiteral permutation[1+VAR_COUNT];
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) permutation[var] = var;
+    for(SddLiteral var=VAR_COUNT; var>1; var--) {
+      SddLiteral other = 1+test_random()%var;
+      SddLiteral tmp = permutation[var]; permutation[var] = permutation[other]; permutation[other] = tmp;
+    }
+
+    SddLiteral* maps[] = { swap, permutation };
+    for(int m=0; m<2; m++) {
+      SddNode* renamed = sdd_ref(sdd_rename_variables(node,maps[m],manager),manager);
+      for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+        CHECK(eval_sdd(renamed,rename_assignment(a,maps[m]))==eval_cnf(&cnf,a));
+      }
+      if(m==0 && round%2) CHECK(sdd_size(renamed)==sdd_size(node)); //structure preserved
+      sdd_deref(renamed,manager);
+    }
+
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
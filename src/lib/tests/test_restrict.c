@@ -0,0 +1,57 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * don't-care minimization: restrict and constrain agree with f on the care set, and
+ * restrict never grows f nor adds variables to it
+ ****************************************************************************************/
+
+#define VAR_COUNT 10
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    TestCnf cnfs[2];
+    random_cnf(VAR_COUNT,VAR_COUNT,3,cnfs);
+    random_cnf(VAR_COUNT,1+round%VAR_COUNT,2,cnfs+1); //care set
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,round%2? "right": "balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    SddNode* f    = compile_cnf(cnfs,manager);
+    SddNode* care = compile_cnf(cnfs+1,manager);
+
+    SddNode* restricted  = sdd_ref(sdd_restrict(f,care,manager),manager);
+    SddNode* constrained = sdd_ref(sdd_constrain(f,care,manager),manager);
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      if(!eval_cnf(cnfs+1,a)) continue; //don't care
+      CHECK(eval_sdd(restricted,a)==eval_cnf(cnfs,a));
+      CHECK(eval_sdd(constrained,a)==eval_cnf(cnfs,a));
+    }
+    CHECK(sdd_size(restricted) <= sdd_size(f));
+    int* f_vars = sdd_variables(f,manager);
+    int* r_vars = sdd_variables(restricted,manager);
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) CHECK(!r_vars[var] || f_vars[var]);
+    free(f_vars);
+    free(r_vars);
+
+    //trivial care sets
+    CHECK(sdd_restrict(f,sdd_manager_true(manager),manager)==f);
+    CHECK(sdd_constrain(f,sdd_manager_true(manager),manager)==f);
+
+    sdd_deref(f,manager);
+    sdd_deref(care,manager);
+    sdd_deref(restricted,manager);
+    sdd_deref(constrained,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,64 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * shadow DAGs: sdd_exists_multiple and vtree fragments (minimization) build them
+ * repeatedly from the shadow arena
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+//value of exists vars in map: cnf
+static int exists_cnf(int* exists_map, TestCnf* cnf, Assignment a) {
+  Assignment mask = 0;
+  for(SddLiteral var=1; var<=VAR_COUNT; var++) {
+    if(exists_map[var]) mask |= 1UL << (var-1);
+  }
+  Assignment b = mask;
+  do { //subsets of mask
+    if(eval_cnf(cnf,(a & ~mask) | b)) return 1;
+    b = (b-1) & mask;
+  } while(b!=mask);
+  return 0;
+}
+
+int main(void) {
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,round%2? "right": "balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+
+    SddNode* node = compile_cnf(&cnf,manager);
+    CHECK(same_as_cnf(node,&cnf));
+
+    for(int i=0; i<4; i++) {
+      int exists_map[1+VAR_COUNT] = {0};
+      for(SddLiteral var=1; var<=VAR_COUNT; var++) exists_map[var] = test_random()%3==0;
+      SddNode* e_node = sdd_ref(sdd_exists_multiple(exists_map,node,manager),manager);
+      sdd_manager_garbage_collect(manager); //cached nodes of shadows may be gc'd
+      for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+        CHECK(eval_sdd(e_node,a)==exists_cnf(exists_map,&cnf,a));
+      }
+      sdd_deref(e_node,manager);
+    }
+
+    sdd_manager_minimize(manager); //vtree fragments
+    CHECK(same_as_cnf(node,&cnf));
+
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,82 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * applies at vtree nodes whose left child is a leaf (right-linear vtrees use them at
+ * every internal node): results are canonical, whatever the order of applies
+ *
+ * the vtrees are right-linear, vertical, and a leaf next to a balanced vtree (only the root
+ * has a leaf as left child), whose results must agree with those of a balanced vtree
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+int main(void) {
+  for(int round=0; round<24; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    const char* types[] = { "right", "vertical", "balanced" };
+    SddManager* manager;
+    if(round%3<2) {
+      Vtree* vtree = sdd_vtree_new(VAR_COUNT,types[round%3]);
+      manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+    }
+    else { //var VAR_COUNT is the left child of the root, the right child is balanced
+      Vtree* vtree = sdd_vtree_new(VAR_COUNT-1,"balanced");
+      manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+      sdd_manager_add_vars(1,'l',0,manager);
+      Vtree* root = sdd_manager_vtree(manager);
+      CHECK(sdd_vtree_is_leaf(sdd_vtree_left(root)) && sdd_vtree_var(sdd_vtree_left(root))==VAR_COUNT);
+      CHECK(!sdd_vtree_is_leaf(sdd_vtree_left(sdd_vtree_right(root))));
+    }
+
+    SddNode* node = compile_cnf(&cnf,manager);
+    CHECK(same_as_cnf(node,&cnf));
+
+    //the same function, clauses conjoined in reverse and in disjunctive form
+    SddNode* reverse = sdd_ref(sdd_manager_true(manager),manager);
+    SddNode* negation = sdd_ref(sdd_manager_false(manager),manager);
+    for(SddSize i=cnf.clause_count; i-- > 0; ) {
+      SddNode* clause = sdd_manager_false(manager);
+      SddNode* term   = sdd_manager_true(manager); //negation of clause
+      for(SddLiteral j=0; j<cnf.lengths[i]; j++) {
+        clause = sdd_disjoin(clause,sdd_manager_literal(cnf.literals[i][j],manager),manager);
+        term   = sdd_conjoin(term,sdd_manager_literal(-cnf.literals[i][j],manager),manager);
+      }
+      SddNode* next = sdd_ref(sdd_conjoin(reverse,clause,manager),manager);
+      sdd_deref(reverse,manager);
+      reverse = next;
+      next = sdd_ref(sdd_disjoin(negation,term,manager),manager);
+      sdd_deref(negation,manager);
+      negation = next;
+    }
+    CHECK(reverse==node);
+    CHECK(negation==sdd_negate(node,manager));
+
+    //the same model count as on a balanced vtree
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+    SddManager* balanced_manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    SddNode* balanced = compile_cnf(&cnf,balanced_manager);
+    CHECK(sdd_global_model_count(node,manager)==sdd_global_model_count(balanced,balanced_manager));
+    sdd_manager_free(balanced_manager);
+
+    sdd_deref(node,manager);
+    sdd_deref(reverse,manager);
+    sdd_deref(negation,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,108 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * sifting: unlimited and limited sifting (including a fragment time limit that aborts
+ * the sifting of leaves) preserve functions and never increase the live size, and
+ * sifting as the auto minimization function compiles correctly
+ *
+ * on (x1 and x2) or (x3 and x4) or ..., whose right-linear sdd is smallest when each pair
+ * is adjacent, sifting from a right-linear vtree moves every leaf next to its partner
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+static SddNode* pairs(SddManager* manager) {
+  SddNode* node = sdd_manager_false(manager);
+  for(SddLiteral var=1; var<VAR_COUNT; var+=2) {
+    SddNode* pair = sdd_conjoin(sdd_manager_literal(var,manager),sdd_manager_literal(var+1,manager),manager);
+    node = sdd_disjoin(node,pair,manager);
+  }
+  return node;
+}
+
+static SddManager* pairs_manager(SddLiteral* var_order) {
+  Vtree* vtree = sdd_vtree_new_with_var_order(VAR_COUNT,var_order,"right");
+  SddManager* manager = sdd_manager_new(vtree);
+  sdd_vtree_free(vtree);
+  return manager;
+}
+
+//sifts the pairs function from a right-linear vtree with var_order: the result is no
+//larger than under the right-linear vtree with adjacent pairs (best_size)
+static void check_pairs(SddLiteral* var_order, SddSize best_size) {
+  SddManager* manager = pairs_manager(var_order);
+  SddNode* node = sdd_ref(pairs(manager),manager);
+  CHECK(sdd_manager_live_size(manager)>best_size);
+
+  sdd_vtree_minimize_sift(sdd_manager_vtree(manager),manager);
+  CHECK(sdd_manager_live_size(manager)<=best_size);
+  SddLiteral order[VAR_COUNT];
+  sdd_manager_var_order(order,manager);
+  for(SddLiteral i=0; i<VAR_COUNT; i+=2) CHECK((order[i]+1)/2==(order[i+1]+1)/2); //partners
+
+  sdd_deref(node,manager);
+  sdd_manager_free(manager);
+}
+
+int main(void) {
+  SddLiteral order[VAR_COUNT];
+  for(SddLiteral i=0; i<VAR_COUNT; i++) order[i] = i+1; //pairs adjacent
+  SddManager* best = pairs_manager(order);
+  sdd_ref(pairs(best),best);
+  SddSize best_size = sdd_manager_live_size(best);
+  sdd_manager_free(best);
+
+  for(SddLiteral i=1; i<VAR_COUNT-1; i++) order[i] = i+2; //x2 at the end
+  order[VAR_COUNT-1] = 2;
+  check_pairs(order,best_size);
+  for(SddLiteral i=0; i<VAR_COUNT/2; i++) { //x1 x3 ... x2 x4 ...
+    order[i]             = 2*i+1;
+    order[VAR_COUNT/2+i] = 2*i+2;
+  }
+  check_pairs(order,best_size);
+
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,round%2? "right": "balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+
+    SddNode* node = compile_cnf(&cnf,manager);
+    CHECK(same_as_cnf(node,&cnf));
+
+    SddSize size = sdd_manager_live_size(manager);
+    sdd_vtree_minimize_sift(sdd_manager_vtree(manager),manager);
+    CHECK(same_as_cnf(node,&cnf));
+    CHECK(sdd_manager_live_size(manager)<=size);
+
+    size = sdd_manager_live_size(manager);
+    if(round%4==0) sdd_manager_set_vtree_fragment_time_limit(1e-6,manager); //aborts leaves
+    sdd_vtree_minimize_sift_limited(sdd_manager_vtree(manager),manager);
+    CHECK(same_as_cnf(node,&cnf));
+    CHECK(sdd_manager_live_size(manager)<=size);
+
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+
+    //sifting as auto minimization
+    manager = sdd_manager_create(VAR_COUNT,1);
+    sdd_manager_set_minimize_function(sdd_vtree_minimize_sift_limited,manager);
+    node = compile_cnf(&cnf,manager);
+    CHECK(same_as_cnf(node,&cnf));
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,63 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include <unistd.h>
+#include "test.h"
+
+/****************************************************************************************
+ * out-of-core node store: nodes compacted into spill files stay valid after their pages
+ * are written out, and the manager keeps working on them; nodes created later for a
+ * spilled vtree are spilled with it, and read back
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+int main(void) {
+  char directory[] = "/tmp/sdd_spill_XXXXXX";
+  CHECK(mkdtemp(directory)!=NULL);
+
+  for(int round=0; round<10; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,2*VAR_COUNT,3,&cnf);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+    SddManager* manager = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    sdd_manager_set_spill_directory(directory,manager);
+
+    SddNode* node = compile_cnf(&cnf,manager);
+    CHECK(sdd_vtree_spill(sdd_manager_vtree(manager),manager)==0); //nothing compacted yet
+    sdd_manager_compact(1,&node,manager);
+    SddSize live = sdd_manager_live_count(manager);
+    CHECK(sdd_vtree_spill(sdd_manager_vtree(manager),manager)==live);
+    CHECK(same_as_cnf(node,&cnf));
+
+    //new nodes over spilled ones are spilled too (in the spill arena)
+    SddNode* negation = sdd_ref(sdd_negate(node,manager),manager);
+    CHECK(sdd_manager_count(manager)>live);
+    CHECK(sdd_vtree_spill(sdd_manager_vtree(manager),manager)==sdd_manager_count(manager));
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      CHECK(eval_sdd(negation,a)==!eval_cnf(&cnf,a));
+    }
+    CHECK(same_as_cnf(node,&cnf));
+
+    //then compact into new spill files
+    sdd_manager_minimize(manager);
+    sdd_deref(negation,manager); //pointers other than roots are invalid after compaction
+    sdd_manager_compact(1,&node,manager);
+    CHECK(same_as_cnf(node,&cnf));
+
+    sdd_deref(node,manager);
+    sdd_manager_free(manager);
+  }
+
+  CHECK(rmdir(directory)==0); //spill files are removed
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,149 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test.h"
+
+/****************************************************************************************
+ * static vtrees from the structure of a cnf (min-fill, min-degree, dtree): each variable
+ * appears once, and the cnf compiled under the vtree is correct; literals of variables
+ * outside 1..var_count are rejected
+ *
+ * for a chain x1-x2-...-xn, elimination orders yield a right-linear vtree that follows
+ * the chain, and the dtree places a cutset variable at the root above the two sides
+ ****************************************************************************************/
+
+#define VAR_COUNT 12
+
+//counts the leaves of each var of vtree in seen
+static void count_leaves(Vtree* vtree, int* seen) {
+  if(sdd_vtree_is_leaf(vtree)) {
+    SddLiteral var = sdd_vtree_var(vtree);
+    CHECK(var>=1 && var<=VAR_COUNT);
+    seen[var]++;
+  }
+  else {
+    count_leaves(sdd_vtree_left(vtree),seen);
+    count_leaves(sdd_vtree_right(vtree),seen);
+  }
+}
+
+//sets min and max to the smallest and largest vars of vtree
+//returns 1 if vtree has exactly the vars min..max
+static int var_range(Vtree* vtree, SddLiteral* min, SddLiteral* max) {
+  SddLiteral vars[VAR_COUNT];
+  SddLiteral count = 0;
+  Vtree* stack[2*VAR_COUNT];
+  SddLiteral top = 0;
+  stack[top++] = vtree;
+  while(top) {
+    Vtree* v = stack[--top];
+    if(sdd_vtree_is_leaf(v)) vars[count++] = sdd_vtree_var(v);
+    else {
+      stack[top++] = sdd_vtree_left(v);
+      stack[top++] = sdd_vtree_right(v);
+    }
+  }
+  *min = *max = vars[0];
+  for(SddLiteral i=1; i<count; i++) {
+    if(vars[i]<*min) *min = vars[i];
+    if(vars[i]>*max) *max = vars[i];
+  }
+  return *max-*min+1==count;
+}
+
+static void check_chain(void) {
+  SddLiteral lengths[VAR_COUNT-1];
+  SddLiteral literals[VAR_COUNT-1][2];
+  SddLiteral* clauses[VAR_COUNT-1];
+  for(SddLiteral i=0; i<VAR_COUNT-1; i++) {
+    lengths[i]     = 2;
+    literals[i][0] = i+1;
+    literals[i][1] = -(i+2);
+    clauses[i]     = literals[i];
+  }
+
+  const char* methods[] = { "min-fill", "min-degree" };
+  for(int m=0; m<2; m++) {
+    Vtree* vtree = sdd_vtree_new_from_cnf(VAR_COUNT,VAR_COUNT-1,lengths,clauses,methods[m]);
+    SddLiteral previous = 0;
+    for(Vtree* v=vtree; ; v=sdd_vtree_right(v)) {
+      Vtree* leaf = sdd_vtree_is_leaf(v)? v: sdd_vtree_left(v);
+      CHECK(sdd_vtree_is_leaf(leaf)); //right-linear
+      CHECK(previous==0 || labs(sdd_vtree_var(leaf)-previous)==1); //follows the chain
+      previous = sdd_vtree_var(leaf);
+      if(sdd_vtree_is_leaf(v)) break;
+    }
+    sdd_vtree_free(vtree);
+  }
+
+  //cutset c at the root, then the vars before c and after c in two subtrees
+  Vtree* vtree = sdd_vtree_new_from_cnf(VAR_COUNT,VAR_COUNT-1,lengths,clauses,"dtree");
+  Vtree* cutset = sdd_vtree_left(vtree);
+  Vtree* sides  = sdd_vtree_right(vtree);
+  CHECK(sdd_vtree_is_leaf(cutset) && !sdd_vtree_is_leaf(sides));
+  SddLiteral c = sdd_vtree_var(cutset);
+  SddLiteral min1, max1, min2, max2;
+  CHECK(var_range(sdd_vtree_left(sides),&min1,&max1));
+  CHECK(var_range(sdd_vtree_right(sides),&min2,&max2));
+  CHECK((max1+1==c && c+1==min2) || (max2+1==c && c+1==min1));
+  sdd_vtree_free(vtree);
+}
+
+//constructing a vtree for a cnf with literal lit exits with an error
+static void check_invalid_literal(SddLiteral lit) {
+  SddLiteral lengths[] = { 2, 1 };
+  SddLiteral clause1[] = { 1, -2 };
+  SddLiteral clause2[] = { lit };
+  SddLiteral* clauses[] = { clause1, clause2 };
+  pid_t pid = fork();
+  CHECK(pid>=0);
+  if(pid==0) {
+    freopen("/dev/null","w",stderr);
+    sdd_vtree_new_from_cnf(VAR_COUNT,2,lengths,clauses,"min-fill");
+    _exit(0);
+  }
+  int status;
+  CHECK(waitpid(pid,&status,0)==pid);
+  CHECK(WIFEXITED(status) && WEXITSTATUS(status)!=0);
+}
+
+int main(void) {
+  check_invalid_literal(0);
+  check_invalid_literal(VAR_COUNT+1);
+  check_invalid_literal(-(VAR_COUNT+1));
+  check_chain();
+
+  const char* methods[] = { "min-fill", "min-degree", "dtree" };
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT-2,round%4==0? 0: VAR_COUNT,3,&cnf); //two vars in no clause
+    cnf.var_count = VAR_COUNT;
+
+    SddLiteral* clauses[TEST_MAX_CLAUSES];
+    for(SddSize i=0; i<cnf.clause_count; i++) clauses[i] = cnf.literals[i];
+
+    for(int m=0; m<3; m++) {
+      Vtree* vtree = sdd_vtree_new_from_cnf(VAR_COUNT,cnf.clause_count,cnf.lengths,clauses,methods[m]);
+      CHECK(sdd_vtree_var_count(vtree)==VAR_COUNT);
+      int seen[1+VAR_COUNT] = {0};
+      count_leaves(vtree,seen);
+      for(SddLiteral var=1; var<=VAR_COUNT; var++) CHECK(seen[var]==1);
+      SddManager* manager = sdd_manager_new(vtree);
+      sdd_vtree_free(vtree);
+      SddNode* node = compile_cnf(&cnf,manager);
+      CHECK(same_as_cnf(node,&cnf));
+      sdd_deref(node,manager);
+      sdd_manager_free(manager);
+    }
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,49 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * transferring sdds between managers with different vtrees
+ ****************************************************************************************/
+
+#define VAR_COUNT 10
+#define NODE_COUNT 3
+
+int main(void) {
+  const char* types[] = { "balanced", "right", "left", "vertical", "random" };
+  for(int round=0; round<20; round++) {
+    TestCnf cnfs[NODE_COUNT];
+    for(int i=0; i<NODE_COUNT; i++) random_cnf(VAR_COUNT,VAR_COUNT,3,cnfs+i);
+
+    Vtree* vtree = sdd_vtree_new(VAR_COUNT,types[round%5]);
+    SddManager* source = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+    vtree = sdd_vtree_new(VAR_COUNT+2,types[(round+1)%5]); //more variables
+    SddManager* dest = sdd_manager_new(vtree);
+    sdd_vtree_free(vtree);
+
+    SddNode* nodes[NODE_COUNT];
+    SddNode* transfers[NODE_COUNT];
+    for(int i=0; i<NODE_COUNT; i++) nodes[i] = compile_cnf(cnfs+i,source);
+
+    SddNode* single = sdd_ref(sdd_transfer(nodes[0],dest),dest);
+    CHECK(same_as_cnf(single,cnfs));
+    sdd_transfer_multiple(NODE_COUNT,nodes,transfers,dest);
+    CHECK(transfers[0]==single); //canonicity
+    for(int i=0; i<NODE_COUNT; i++) CHECK(same_as_cnf(transfers[i],cnfs+i));
+
+    sdd_deref(single,dest);
+    for(int i=0; i<NODE_COUNT; i++) sdd_deref(nodes[i],source);
+    sdd_manager_free(source);
+    sdd_manager_free(dest);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/
@@ -0,0 +1,131 @@
+/****************************************************************************************
+ * The Sentential Decision Diagram Package
+ * sdd version 2.0, January 8, 2018
+ * http://reasoning.cs.ucla.edu/sdd
+ ****************************************************************************************/
+
+#include "test.h"
+
+/****************************************************************************************
+ * adding variables in bulk and removing unused variables
+ ****************************************************************************************/
+
+#define VAR_COUNT 8
+#define ADDED_COUNT 5
+
+//assignment of the renumbered vars from an assignment of the original vars
+static Assignment renumber(Assignment a, SddLiteral* map, SddLiteral var_count) {
+  Assignment b = 0;
+  for(SddLiteral var=1; var<=var_count; var++) {
+    if(map[var] && value_of(var,a)) b |= 1UL << (map[var]-1);
+  }
+  return b;
+}
+
+//vtree is the balanced vtree over first_var..last_var built by sdd_manager_add_vars
+static int is_balanced(Vtree* vtree, SddLiteral first_var, SddLiteral last_var) {
+  if(first_var==last_var) return sdd_vtree_is_leaf(vtree) && sdd_vtree_var(vtree)==first_var;
+  SddLiteral mid_var = first_var+(last_var-first_var)/2;
+  return !sdd_vtree_is_leaf(vtree) &&
+         is_balanced(sdd_vtree_left(vtree),first_var,mid_var) &&
+         is_balanced(sdd_vtree_right(vtree),mid_var+1,last_var);
+}
+
+//positions of vtree nodes follow their inorder, starting at *position
+static void check_positions(Vtree* vtree, SddLiteral* position) {
+  if(!sdd_vtree_is_leaf(vtree)) check_positions(sdd_vtree_left(vtree),position);
+  CHECK(sdd_vtree_position(vtree)==(*position)++);
+  if(!sdd_vtree_is_leaf(vtree)) check_positions(sdd_vtree_right(vtree),position);
+}
+
+//adds ADDED_COUNT vars before/after target_var (the root if 0) of a manager holding a cnf
+static void check_add_vars(char location, SddLiteral target_var) {
+  TestCnf cnf;
+  random_cnf(VAR_COUNT,VAR_COUNT,3,&cnf);
+  Vtree* vtree = sdd_vtree_new(VAR_COUNT,"balanced");
+  SddManager* manager = sdd_manager_new(vtree);
+  sdd_vtree_free(vtree);
+  SddNode* node = compile_cnf(&cnf,manager);
+  Vtree* sibling = target_var==0? sdd_manager_vtree(manager): sdd_manager_vtree_of_var(target_var,manager);
+  SddLiteral sibling_var_count = sdd_vtree_var_count(sibling);
+
+  sdd_manager_add_vars(ADDED_COUNT,location,target_var,manager);
+  SddLiteral var_count = VAR_COUNT+ADDED_COUNT;
+  CHECK(sdd_manager_var_count(manager)==var_count);
+  CHECK(sdd_vtree_var_count(sdd_manager_vtree(manager))==var_count);
+
+  //added vars form a balanced vtree, which is the sibling of the target vtree
+  Vtree* parent = sdd_vtree_parent(sibling);
+  CHECK(parent!=NULL);
+  CHECK(sdd_vtree_var_count(parent)==sibling_var_count+ADDED_COUNT);
+  Vtree* added = location=='l'? sdd_vtree_left(parent): sdd_vtree_right(parent);
+  CHECK((location=='l'? sdd_vtree_right(parent): sdd_vtree_left(parent))==sibling);
+  CHECK(is_balanced(added,VAR_COUNT+1,var_count));
+  if(target_var==0) CHECK(parent==sdd_manager_vtree(manager));
+  for(SddLiteral var=VAR_COUNT+1; var<=var_count; var++) {
+    CHECK(sdd_vtree_var(sdd_manager_vtree_of_var(var,manager))==var);
+  }
+  SddLiteral position = 0;
+  check_positions(sdd_manager_vtree(manager),&position);
+  CHECK(position==2*var_count-1);
+
+  //existing sdds keep their functions, and added vars can be used
+  CHECK(same_as_cnf(node,&cnf));
+  SddNode* conjunction = sdd_conjoin(node,sdd_manager_literal(-var_count,manager),manager);
+  for(Assignment a=0; a < (1UL << var_count); a++) {
+    CHECK(eval_sdd(conjunction,a)==(eval_cnf(&cnf,a) && !value_of(var_count,a)));
+  }
+  sdd_deref(node,manager);
+  sdd_manager_free(manager);
+}
+
+int main(void) {
+  for(int round=0; round<4; round++) {
+    check_add_vars('l',1+round);
+    check_add_vars('r',VAR_COUNT-round);
+  }
+  check_add_vars('l',0);
+  check_add_vars('r',0);
+
+  for(int round=0; round<20; round++) {
+    TestCnf cnf;
+    random_cnf(VAR_COUNT,VAR_COUNT,3,&cnf);
+
+    SddManager* manager = sdd_manager_create(VAR_COUNT,0);
+    //unused vars VAR_COUNT+1..2*VAR_COUNT, placed after each var of cnf in the vtree
+    for(SddLiteral var=1; var<=VAR_COUNT; var++) sdd_manager_add_vars(1,'r',var,manager);
+    CHECK(sdd_manager_var_count(manager)==2*VAR_COUNT);
+
+    SddNode* node = compile_cnf(&cnf,manager);
+    sdd_manager_hold_var(VAR_COUNT+3,manager); //unused var
+    SddNode* held = sdd_manager_literal(-(VAR_COUNT+3),manager);
+    sdd_ref(sdd_manager_literal(VAR_COUNT+5,manager),manager); //literals are not reference counted
+    SddModelCount count = sdd_model_count(node,manager);
+
+    SddLiteral map[1+2*VAR_COUNT];
+    SddLiteral removed = sdd_manager_remove_unused_vars(map,manager);
+    SddLiteral kept    = sdd_manager_var_count(manager);
+    CHECK(removed+kept==2*VAR_COUNT);
+    CHECK(map[VAR_COUNT+3]==kept); //held literal keeps its var (largest index)
+    CHECK(sdd_node_is_literal(held) && sdd_node_literal(held)==-kept);
+    for(SddLiteral var=1; var<2*VAR_COUNT; var++) {
+      if(map[var] && map[var+1]) CHECK(map[var] < map[var+1]);
+      if(var>VAR_COUNT && var!=VAR_COUNT+3) CHECK(map[var]==0); //unused
+    }
+    for(Assignment a=0; a < (1UL << VAR_COUNT); a++) {
+      CHECK(eval_sdd(node,renumber(a,map,VAR_COUNT))==eval_cnf(&cnf,a));
+    }
+    CHECK(sdd_model_count(node,manager)==count);
+
+    sdd_manager_release_var(kept,manager);
+    sdd_deref(node,manager);
+    sdd_manager_remove_unused_vars(NULL,manager);
+    CHECK(sdd_manager_var_count(manager)==1);
+    sdd_manager_free(manager);
+  }
+  return 0;
+}
+
+/****************************************************************************************
+ * end
+ ****************************************************************************************/